@@ -28,6 +28,7 @@
 
 /* Include Adafruit GFX library */
 #include "RGBmatrixPanel.h"
+#include "RGBmatrixScene.h"
 #include "bit_bmp.h"
 #include "fonts.h"
 
@@ -58,6 +59,12 @@ typedef enum {
     SIZE_4_PIXELS  = 4,
 } text_size_t_en;
 
+typedef struct benchmark_case_st {
+    const char *name;              // primitive name
+    void (*generic)(uint16_t i);   // per-pixel Adafruit_GFX path
+    void (*native)(uint16_t i);    // RGBmatrixPanel span writer
+} benchmark_case_t_st;
+
 typedef enum {
     LED_MATRIX_SUCCESS = 0,
     LED_MATRIX_ERROR_INVALID_ARGUMENTS = -1,
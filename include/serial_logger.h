@@ -39,6 +39,15 @@
                                         printf(fmt "\r\n", ##__VA_ARGS__)
 #define LOG_DEBUG(fmt, ...)             printf("[DEBUG]: "); \
                                         printf(fmt "\r\n", ##__VA_ARGS__)
+#ifdef ARDUINO_ARCH_NATIVE
+/**
+ * @brief Setup serial logger (host build: Serial and stdout are both the terminal)
+ */
+void setup_serial_logger(void) {
+
+    Serial.begin(BAUDRATE);
+}
+#else
 FILE f_out;
 
 int sput(char c, __attribute__((unused)) FILE* f) {
@@ -57,6 +66,7 @@ void setup_serial_logger(void) {
     fdev_setup_stream(&f_out, sput, NULL, _FDEV_SETUP_WRITE);
     stdout = &f_out;
 }
+#endif
 
 #pragma message("Debug enabled")
 
@@ -90,6 +90,10 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
+#define CLIP_OUTSIDE 0 ///< clipBox(): nothing of the box is drawn
+#define CLIP_PARTIAL 1 ///< clipBox(): some of the box is drawn
+#define CLIP_INSIDE 2  ///< clipBox(): all of the box is drawn
+
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
   {                                                                            \
@@ -117,6 +121,7 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  resetClip();
 }
 
 /**************************************************************************/
@@ -134,6 +139,11 @@ void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 #if defined(ESP8266)
   yield();
 #endif
+  uint8_t clip = clipBox(x0, y0, x1, y1);
+  if (clip == CLIP_OUTSIDE)
+    return;
+  bool inside = (clip == CLIP_INSIDE);
+
   int16_t steep = abs(y1 - y0) > abs(x1 - x0);
   if (steep) {
     _swap_int16_t(x0, y0);
@@ -160,9 +170,9 @@ void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 
   for (; x0 <= x1; x0++) {
     if (steep) {
-      writePixel(y0, x0, color);
+      writeClipPixel(y0, x0, color, inside);
     } else {
-      writePixel(x0, y0, color);
+      writeClipPixel(x0, y0, color, inside);
     }
     err -= dy;
     if (err < 0) {
@@ -182,12 +192,29 @@ void Adafruit_GFX::startWrite() {}
 /**************************************************************************/
 /*!
    @brief    Write a pixel, overwrite in subclasses if startWrite is defined!
+   Pixels outside the clip rectangle are dropped here, so primitives stay
+   clipped even if the subclass's drawPixel() only checks the display.
     @param   x   x coordinate
     @param   y   y coordinate
    @param    color 16-bit 5-6-5 Color to fill with
 */
 /**************************************************************************/
 void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color) {
+  if (inClip(x, y))
+    writePixelUnchecked(x, y, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Write a pixel the caller has already found inside the clip
+   rectangle (see setClipRect()), so no check is needed.  Overwrite in
+   subclasses with a version that skips drawPixel()'s bounds check!
+    @param   x   x coordinate
+    @param   y   y coordinate
+   @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_GFX::writePixelUnchecked(int16_t x, int16_t y, uint16_t color) {
   drawPixel(x, y, color);
 }
 
@@ -264,8 +291,19 @@ void Adafruit_GFX::endWrite() {}
 /**************************************************************************/
 void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                  uint16_t color) {
+  // The pixels of writeLine(x, y, x, y + h - 1), clipped here so that
+  // writeLine() finds them inside
+  int16_t y0 = y, y1 = y + h - 1;
+  if (y0 > y1)
+    _swap_int16_t(y0, y1);
+  if (y0 < clip_y0)
+    y0 = clip_y0;
+  if (y1 >= clip_y1)
+    y1 = clip_y1 - 1;
+  if ((x < clip_x0) || (x >= clip_x1) || (y0 > y1))
+    return;
   // startWrite();
-  writeLine(x, y, x, y + h - 1, color);
+  writeLine(x, y0, x, y1, color);
   // endWrite();
 }
 
@@ -281,8 +319,19 @@ void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                  uint16_t color) {
+  // The pixels of writeLine(x, y, x + w - 1, y), clipped here so that
+  // writeLine() finds them inside
+  int16_t x0 = x, x1 = x + w - 1;
+  if (x0 > x1)
+    _swap_int16_t(x0, x1);
+  if (x0 < clip_x0)
+    x0 = clip_x0;
+  if (x1 >= clip_x1)
+    x1 = clip_x1 - 1;
+  if ((y < clip_y0) || (y >= clip_y1) || (x0 > x1))
+    return;
   startWrite();
-  writeLine(x, y, x + w - 1, y, color);
+  writeLine(x0, y, x1, y, color);
   endWrite();
 }
 
@@ -299,8 +348,10 @@ void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  // Only the columns inside the clip rectangle
+  int16_t x1 = min((int16_t)(x + w), clip_x1);
   // startWrite();
-  for (int16_t i = x; i < x + w; i++) {
+  for (int16_t i = max(x, clip_x0); i < x1; i++) {
     writeFastVLine(i, y, h, color);
   }
   // endWrite();
@@ -364,12 +415,16 @@ void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
   int16_t ddF_y = -2 * r;
   int16_t x = 0;
   int16_t y = r;
+  uint8_t clip = clipBox(x0 - r, y0 - r, x0 + r, y0 + r);
+  if (clip == CLIP_OUTSIDE)
+    return;
+  bool inside = (clip == CLIP_INSIDE);
 
   startWrite();
-  writePixel(x0, y0 + r, color);
-  writePixel(x0, y0 - r, color);
-  writePixel(x0 + r, y0, color);
-  writePixel(x0 - r, y0, color);
+  writeClipPixel(x0, y0 + r, color, inside);
+  writeClipPixel(x0, y0 - r, color, inside);
+  writeClipPixel(x0 + r, y0, color, inside);
+  writeClipPixel(x0 - r, y0, color, inside);
 
   while (x < y) {
     if (f >= 0) {
@@ -381,14 +436,14 @@ void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
     ddF_x += 2;
     f += ddF_x;
 
-    writePixel(x0 + x, y0 + y, color);
-    writePixel(x0 - x, y0 + y, color);
-    writePixel(x0 + x, y0 - y, color);
-    writePixel(x0 - x, y0 - y, color);
-    writePixel(x0 + y, y0 + x, color);
-    writePixel(x0 - y, y0 + x, color);
-    writePixel(x0 + y, y0 - x, color);
-    writePixel(x0 - y, y0 - x, color);
+    writeClipPixel(x0 + x, y0 + y, color, inside);
+    writeClipPixel(x0 - x, y0 + y, color, inside);
+    writeClipPixel(x0 + x, y0 - y, color, inside);
+    writeClipPixel(x0 - x, y0 - y, color, inside);
+    writeClipPixel(x0 + y, y0 + x, color, inside);
+    writeClipPixel(x0 - y, y0 + x, color, inside);
+    writeClipPixel(x0 + y, y0 - x, color, inside);
+    writeClipPixel(x0 - y, y0 - x, color, inside);
   }
   endWrite();
 }
@@ -411,6 +466,10 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
   int16_t ddF_y = -2 * r;
   int16_t x = 0;
   int16_t y = r;
+  uint8_t clip = clipBox(x0 - r, y0 - r, x0 + r, y0 + r);
+  if (clip == CLIP_OUTSIDE)
+    return;
+  bool inside = (clip == CLIP_INSIDE);
 
   while (x < y) {
     if (f >= 0) {
@@ -422,20 +481,20 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
     ddF_x += 2;
     f += ddF_x;
     if (cornername & 0x4) {
-      writePixel(x0 + x, y0 + y, color);
-      writePixel(x0 + y, y0 + x, color);
+      writeClipPixel(x0 + x, y0 + y, color, inside);
+      writeClipPixel(x0 + y, y0 + x, color, inside);
     }
     if (cornername & 0x2) {
-      writePixel(x0 + x, y0 - y, color);
-      writePixel(x0 + y, y0 - x, color);
+      writeClipPixel(x0 + x, y0 - y, color, inside);
+      writeClipPixel(x0 + y, y0 - x, color, inside);
     }
     if (cornername & 0x8) {
-      writePixel(x0 - y, y0 + x, color);
-      writePixel(x0 - x, y0 + y, color);
+      writeClipPixel(x0 - y, y0 + x, color, inside);
+      writeClipPixel(x0 - x, y0 + y, color, inside);
     }
     if (cornername & 0x1) {
-      writePixel(x0 - y, y0 - x, color);
-      writePixel(x0 - x, y0 - y, color);
+      writeClipPixel(x0 - y, y0 - x, color, inside);
+      writeClipPixel(x0 - x, y0 - y, color, inside);
     }
   }
 }
@@ -720,15 +779,19 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
 
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]) << (i & 7);
       if (byte & 0x80)
-        writePixel(x + i, y, color);
+        writePixelUnchecked(x + i, y + j, color);
     }
   }
   endWrite();
@@ -755,14 +818,18 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
 
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
+        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]) << (i & 7);
+      writePixelUnchecked(x + i, y + j, (byte & 0x80) ? color : bg);
     }
   }
   endWrite();
@@ -786,15 +853,19 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
 
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = bitmap[j * byteWidth + i / 8];
+        byte = bitmap[j * byteWidth + i / 8] << (i & 7);
       if (byte & 0x80)
-        writePixel(x + i, y, color);
+        writePixelUnchecked(x + i, y + j, color);
     }
   }
   endWrite();
@@ -820,14 +891,18 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
 
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = bitmap[j * byteWidth + i / 8];
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
+        byte = bitmap[j * byteWidth + i / 8] << (i & 7);
+      writePixelUnchecked(x + i, y + j, (byte & 0x80) ? color : bg);
     }
   }
   endWrite();
@@ -854,17 +929,21 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
 
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte >>= 1;
       else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]) >> (i & 7);
       // Nearly identical to drawBitmap(), only the bit order
       // is reversed here (left-to-right = LSB to MSB):
       if (byte & 0x01)
-        writePixel(x + i, y, color);
+        writePixelUnchecked(x + i, y + j, color);
     }
   }
   endWrite();
@@ -885,10 +964,15 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        const uint8_t bitmap[], int16_t w,
                                        int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      writePixelUnchecked(x + i, y + j,
+                          (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
     }
   }
   endWrite();
@@ -908,10 +992,14 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
 /**************************************************************************/
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        int16_t w, int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      writePixelUnchecked(x + i, y + j, bitmap[j * w + i]);
     }
   }
   endWrite();
@@ -938,15 +1026,20 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        int16_t h) {
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = pgm_read_byte(&mask[j * bw + i / 8]);
+        byte = pgm_read_byte(&mask[j * bw + i / 8]) << (i & 7);
       if (byte & 0x80) {
-        writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+        writePixelUnchecked(x + i, y + j,
+                            (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
       }
     }
   }
@@ -972,15 +1065,19 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        uint8_t *mask, int16_t w, int16_t h) {
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = mask[j * bw + i / 8];
+        byte = mask[j * bw + i / 8] << (i & 7);
       if (byte & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
+        writePixelUnchecked(x + i, y + j, bitmap[j * w + i]);
       }
     }
   }
@@ -1002,17 +1099,21 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
 #define MSB_first 0
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  int16_t w, int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
 #if bmp_data_bits == 8
 #if MSB_first
-      writePixel(x + i, y, (pgm_read_word(&bitmap[j * 2 * w + 2 * i]) << 8) | pgm_read_word(&bitmap[j * 2 * w + 2 * i + 1]));
+      writePixelUnchecked(x + i, y + j, (pgm_read_word(&bitmap[j * 2 * w + 2 * i]) << 8) | pgm_read_word(&bitmap[j * 2 * w + 2 * i + 1]));
 #else
-      writePixel(x + i, y, pgm_read_word(&bitmap[j * 2 * w + 2 * i])  | (pgm_read_word(&bitmap[j * 2 * w + 2 * i + 1]) << 8));
+      writePixelUnchecked(x + i, y + j, pgm_read_word(&bitmap[j * 2 * w + 2 * i])  | (pgm_read_word(&bitmap[j * 2 * w + 2 * i + 1]) << 8));
 #endif
 #elif bmp_data_bits == 16
-      writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+      writePixelUnchecked(x + i, y + j, pgm_read_word(&bitmap[j * w + i]));
 #endif
     }
   }
@@ -1032,10 +1133,14 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  int16_t w, int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      writePixelUnchecked(x + i, y + j, bitmap[j * w + i]);
     }
   }
   endWrite();
@@ -1059,15 +1164,19 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  const uint8_t mask[], int16_t w, int16_t h) {
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = pgm_read_byte(&mask[j * bw + i / 8]);
+        byte = pgm_read_byte(&mask[j * bw + i / 8]) << (i & 7);
       if (byte & 0x80) {
-        writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+        writePixelUnchecked(x + i, y + j, pgm_read_word(&bitmap[j * w + i]));
       }
     }
   }
@@ -1092,15 +1201,19 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  uint8_t *mask, int16_t w, int16_t h) {
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0))
         byte <<= 1;
       else
-        byte = mask[j * bw + i / 8];
+        byte = mask[j * bw + i / 8] << (i & 7);
       if (byte & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
+        writePixelUnchecked(x + i, y + j, bitmap[j * w + i]);
       }
     }
   }
@@ -1147,11 +1260,10 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 
   if (!gfxFont) { // 'Classic' built-in font
 
-    if ((x >= _width) ||              // Clip right
-        (y >= _height) ||             // Clip bottom
-        ((x + 6 * size_x - 1) < 0) || // Clip left
-        ((y + 8 * size_y - 1) < 0))   // Clip top
+    uint8_t clip = clipBox(x, y, x + 6 * size_x - 1, y + 8 * size_y - 1);
+    if (clip == CLIP_OUTSIDE)
       return;
+    bool inside = (clip == CLIP_INSIDE);
 
     if (!_cp437 && (c >= 176))
       c++; // Handle 'classic' charset behavior
@@ -1162,13 +1274,13 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
       for (int8_t j = 0; j < 8; j++, line >>= 1) {
         if (line & 1) {
           if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, color);
+            writeClipPixel(x + i, y + j, color, inside);
           else
             writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
                           color);
         } else if (bg != color) {
           if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, bg);
+            writeClipPixel(x + i, y + j, bg, inside);
           else
             writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
         }
@@ -1204,7 +1316,13 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
       yo16 = yo;
     }
 
-    // Todo: Add character clipping here
+    // Clip the glyph's box once
+    uint8_t clip = clipBox(x + xo * size_x, y + yo * size_y,
+                           x + (xo + w) * size_x - 1,
+                           y + (yo + h) * size_y - 1);
+    if (clip == CLIP_OUTSIDE)
+      return;
+    bool inside = (clip == CLIP_INSIDE);
 
     // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
     // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
@@ -1230,7 +1348,7 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
         }
         if (bits & 0x80) {
           if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
+            writeClipPixel(x + xo + xx, y + yo + yy, color, inside);
           } else {
             writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
                           size_x, size_y, color);
@@ -1339,6 +1457,115 @@ void Adafruit_GFX::setRotation(uint8_t x) {
       _height = WIDTH;
       break;
   }
+  resetClip();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Restrict drawing to a rectangle of the display, e.g. one pane of
+   a split screen.  Every primitive then leaves the pixels outside it
+   alone, and tests itself against it once, up front: what lies wholly
+   outside is skipped, what lies wholly inside is drawn without a check
+   per pixel.  Lines, circles and glyphs that straddle the edge still
+   check each pixel; rectangles and bitmaps are cut down to the part
+   inside.  The rectangle is in the current rotation's coordinates and is
+   reset by setRotation().  A subclass only has to override drawPixel()
+   for the primitives to be clipped (writePixel() checks); its own
+   drawPixel(), fast lines, fillRect() and fillScreen() must test the
+   rectangle themselves (see inClip()) to be clipped when called directly,
+   as the canvases do.
+    @param  x  Left edge
+    @param  y  Top edge
+    @param  w  Width, clipped to the display
+    @param  h  Height, clipped to the display
+*/
+/**************************************************************************/
+void Adafruit_GFX::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int32_t x1 = (int32_t)x + w, y1 = (int32_t)y + h;
+
+  clip_x0 = max(x, (int16_t)0);
+  clip_y0 = max(y, (int16_t)0);
+  clip_x1 = (x1 < _width) ? x1 : _width;
+  clip_y1 = (y1 < _height) ? y1 : _height;
+  if ((clip_x0 >= clip_x1) || (clip_y0 >= clip_y1)) // Nothing left
+    clip_x0 = clip_y0 = clip_x1 = clip_y1 = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw on the whole display again, see setClipRect()
+*/
+/**************************************************************************/
+void Adafruit_GFX::resetClip(void) {
+  clip_x0 = clip_y0 = 0;
+  clip_x1 = _width;
+  clip_y1 = _height;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the rectangle drawing is restricted to, see setClipRect()
+    @param  x  Left edge
+    @param  y  Top edge
+    @param  w  Width (0 if nothing is drawn)
+    @param  h  Height
+*/
+/**************************************************************************/
+void Adafruit_GFX::getClipRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  *x = clip_x0;
+  *y = clip_y0;
+  *w = clip_x1 - clip_x0;
+  *h = clip_y1 - clip_y0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Find where a box lies against the clip rectangle
+    @param  x0  One corner's x coordinate
+    @param  y0  One corner's y coordinate
+    @param  x1  The opposite corner's x coordinate (included)
+    @param  y1  The opposite corner's y coordinate (included)
+    @returns  CLIP_OUTSIDE, CLIP_PARTIAL or CLIP_INSIDE
+*/
+/**************************************************************************/
+uint8_t Adafruit_GFX::clipBox(int16_t x0, int16_t y0, int16_t x1,
+                              int16_t y1) const {
+  if (x0 > x1)
+    _swap_int16_t(x0, x1);
+  if (y0 > y1)
+    _swap_int16_t(y0, y1);
+  if ((x1 < clip_x0) || (y1 < clip_y0) || (x0 >= clip_x1) ||
+      (y0 >= clip_y1))
+    return CLIP_OUTSIDE;
+  if ((x0 >= clip_x0) && (y0 >= clip_y0) && (x1 < clip_x1) &&
+      (y1 < clip_y1))
+    return CLIP_INSIDE;
+  return CLIP_PARTIAL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Find the part of an image inside the clip rectangle
+    @param  x   Image's left edge on the display
+    @param  y   Image's top edge on the display
+    @param  w   Image width
+    @param  h   Image height
+    @param  i0  First image column inside
+    @param  j0  First image row inside
+    @param  i1  Image column after the last one inside
+    @param  j1  Image row after the last one inside
+    @returns  False if nothing of the image is inside
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipImage(int16_t x, int16_t y, int16_t w, int16_t h,
+                             int16_t *i0, int16_t *j0, int16_t *i1,
+                             int16_t *j1) const {
+  *i0 = (x < clip_x0) ? (clip_x0 - x) : 0;
+  *j0 = (y < clip_y0) ? (clip_y0 - y) : 0;
+  *i1 = (x + w > clip_x1) ? (clip_x1 - x) : w;
+  *j1 = (y + h > clip_y1) ? (clip_y1 - y) : h;
+  return (*i0 < *i1) && (*j0 < *j1);
 }
 
 /**************************************************************************/
@@ -1806,10 +2033,21 @@ GFXcanvas1::~GFXcanvas1(void) {
 */
 /**************************************************************************/
 void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
-      return;
+  if (inClip(x, y))
+    GFXcanvas1::writePixelUnchecked(x, y, color);
+}
 
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer, known to be inside
+            the clip rectangle
+    @param  x     x coordinate
+    @param  y     y coordinate
+    @param  color Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::writePixelUnchecked(int16_t x, int16_t y, uint16_t color) {
+  if (buffer) {
     int16_t t;
     switch (rotation) {
       case 1:
@@ -1907,6 +2145,10 @@ bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas1::fillScreen(uint16_t color) {
+  if (!clipIsScreen()) { // Only the clip rectangle
+    Adafruit_GFX::fillScreen(color);
+    return;
+  }
   if (buffer) {
     uint16_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
     memset(buffer, color ? 0xFF : 0x00, bytes);
@@ -1928,23 +2170,20 @@ void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
-    if (y < 0) {
-      h += y;
-      y = 0;
-    }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally outside the clip rectangle)
+  if ((x < clip_x0) || (x >= clip_x1) || (y >= clip_y1) ||
+      ((y + h - 1) < clip_y0)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < clip_y0) { // Clip top
+    h -= clip_y0 - y;
+    y = clip_y0;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > clip_y1) { // Clip bottom
+    h = clip_y1 - y;
   }
 
   if (getRotation() == 0) {
@@ -1983,23 +2222,20 @@ void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
-    if (x < 0) {
-      w += x;
-      x = 0;
-    }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally outside the clip rectangle)
+  if ((y < clip_y0) || (y >= clip_y1) || (x >= clip_x1) ||
+      ((x + w - 1) < clip_x0)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < clip_x0) { // Clip left
+    w -= clip_x0 - x;
+    x = clip_x0;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w > clip_x1) { // Clip right
+    w = clip_x1 - x;
   }
 
   if (getRotation() == 0) {
@@ -2162,10 +2398,21 @@ GFXcanvas8::~GFXcanvas8(void) {
 */
 /**************************************************************************/
 void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
-      return;
+  if (inClip(x, y))
+    GFXcanvas8::writePixelUnchecked(x, y, color);
+}
 
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer, known to be inside
+            the clip rectangle
+    @param  x   x coordinate
+    @param  y   y coordinate
+    @param  color 8-bit Color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::writePixelUnchecked(int16_t x, int16_t y, uint16_t color) {
+  if (buffer) {
     int16_t t;
     switch (rotation) {
       case 1:
@@ -2243,6 +2490,10 @@ uint8_t GFXcanvas8::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas8::fillScreen(uint16_t color) {
+  if (!clipIsScreen()) { // Only the clip rectangle
+    Adafruit_GFX::fillScreen(color);
+    return;
+  }
   if (buffer) {
     memset(buffer, color, WIDTH * HEIGHT);
   }
@@ -2263,23 +2514,20 @@ void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
-    if (y < 0) {
-      h += y;
-      y = 0;
-    }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally outside the clip rectangle)
+  if ((x < clip_x0) || (x >= clip_x1) || (y >= clip_y1) ||
+      ((y + h - 1) < clip_y0)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < clip_y0) { // Clip top
+    h -= clip_y0 - y;
+    y = clip_y0;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > clip_y1) { // Clip bottom
+    h = clip_y1 - y;
   }
 
   if (getRotation() == 0) {
@@ -2320,23 +2568,20 @@ void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
-    if (x < 0) {
-      w += x;
-      x = 0;
-    }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally outside the clip rectangle)
+  if ((y < clip_y0) || (y >= clip_y1) || (x >= clip_x1) ||
+      ((x + w - 1) < clip_x0)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < clip_x0) { // Clip left
+    w -= clip_x0 - x;
+    x = clip_x0;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w > clip_x1) { // Clip right
+    w = clip_x1 - x;
   }
 
   if (getRotation() == 0) {
@@ -2430,10 +2675,21 @@ GFXcanvas16::~GFXcanvas16(void) {
 */
 /**************************************************************************/
 void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
-      return;
+  if (inClip(x, y))
+    GFXcanvas16::writePixelUnchecked(x, y, color);
+}
 
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer, known to be inside
+            the clip rectangle
+    @param  x   x coordinate
+    @param  y   y coordinate
+    @param  color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::writePixelUnchecked(int16_t x, int16_t y, uint16_t color) {
+  if (buffer) {
     int16_t t;
     switch (rotation) {
       case 1:
@@ -2511,6 +2767,10 @@ uint16_t GFXcanvas16::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas16::fillScreen(uint16_t color) {
+  if (!clipIsScreen()) { // Only the clip rectangle
+    Adafruit_GFX::fillScreen(color);
+    return;
+  }
   if (buffer) {
     uint8_t hi = color >> 8, lo = color & 0xFF;
     if (hi == lo) {
@@ -2558,23 +2818,20 @@ void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
-    if (y < 0) {
-      h += y;
-      y = 0;
-    }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally outside the clip rectangle)
+  if ((x < clip_x0) || (x >= clip_x1) || (y >= clip_y1) ||
+      ((y + h - 1) < clip_y0)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < clip_y0) { // Clip top
+    h -= clip_y0 - y;
+    y = clip_y0;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > clip_y1) { // Clip bottom
+    h = clip_y1 - y;
   }
 
   if (getRotation() == 0) {
@@ -2613,23 +2870,20 @@ void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
-    if (x < 0) {
-      w += x;
-      x = 0;
-    }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally outside the clip rectangle)
+  if ((y < clip_y0) || (y >= clip_y1) || (x >= clip_x1) ||
+      ((x + w - 1) < clip_x0)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < clip_x0) { // Clip left
+    w -= clip_x0 - x;
+    x = clip_x0;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w > clip_x1) { // Clip right
+    w = clip_x1 - x;
   }
 
   if (getRotation() == 0) {
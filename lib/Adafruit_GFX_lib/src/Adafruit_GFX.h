@@ -33,6 +33,7 @@ public:
   // optimized code.  Otherwise 'generic' versions are used.
   virtual void startWrite(void);
   virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+  virtual void writePixelUnchecked(int16_t x, int16_t y, uint16_t color);
   virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                              uint16_t color);
   virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
@@ -46,6 +47,9 @@ public:
   // optimized code.  Otherwise 'generic' versions are used.
   virtual void setRotation(uint8_t r);
   virtual void invertDisplay(bool i);
+  void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void resetClip(void);
+  void getClipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
 
   // BASIC DRAW API
   // These MAY be overridden by the subclass to provide device-specific
@@ -229,10 +233,58 @@ public:
 protected:
   void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
-  int16_t WIDTH;        ///< This is the 'raw' display width - never changes
+  uint8_t clipBox(int16_t x0, int16_t y0, int16_t x1, int16_t y1) const;
+  bool clipImage(int16_t x, int16_t y, int16_t w, int16_t h, int16_t *i0,
+                 int16_t *j0, int16_t *i1, int16_t *j1) const;
+
+  /**********************************************************************/
+  /*!
+    @brief  Check a pixel against the clip rectangle
+    @param  x  X coordinate in pixels
+    @param  y  Y coordinate in pixels
+    @returns  True if the pixel is to be drawn
+  */
+  /**********************************************************************/
+  bool inClip(int16_t x, int16_t y) const {
+    return (x >= clip_x0) && (y >= clip_y0) && (x < clip_x1) && (y < clip_y1);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Check whether the clip rectangle is the whole display
+    @returns  True if nothing is clipped but what falls off the display
+  */
+  /**********************************************************************/
+  bool clipIsScreen(void) const {
+    return !clip_x0 && !clip_y0 && (clip_x1 == _width) &&
+           (clip_y1 == _height);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  writePixel(), or writePixelUnchecked() for a primitive that has
+            found itself wholly inside the clip rectangle
+    @param  x       X coordinate in pixels
+    @param  y       Y coordinate in pixels
+    @param  color   16-bit pixel color
+    @param  inside  True to skip the clip check
+  */
+  /**********************************************************************/
+  void writeClipPixel(int16_t x, int16_t y, uint16_t color, bool inside) {
+    if (inside)
+      writePixelUnchecked(x, y, color);
+    else
+      writePixel(x, y, color);
+  }
+
+  int16_t WIDTH;       ///< This is the 'raw' display width - never changes
   int16_t HEIGHT;       ///< This is the 'raw' display height - never changes
   int16_t _width;       ///< Display width as modified by current rotation
   int16_t _height;      ///< Display height as modified by current rotation
+  int16_t clip_x0;      ///< Left edge of the clip rectangle
+  int16_t clip_y0;      ///< Top edge of the clip rectangle
+  int16_t clip_x1;      ///< Right edge of the clip rectangle, exclusive
+  int16_t clip_y1;      ///< Bottom edge of the clip rectangle, exclusive
   int16_t cursor_x;     ///< x location to start print()ing text
   int16_t cursor_y;     ///< y location to start print()ing text
   uint16_t textcolor;   ///< 16-bit background color for print()
@@ -309,6 +361,7 @@ public:
   GFXcanvas1(uint16_t w, uint16_t h);
   ~GFXcanvas1(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void writePixelUnchecked(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -341,6 +394,7 @@ public:
   GFXcanvas8(uint16_t w, uint16_t h);
   ~GFXcanvas8(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void writePixelUnchecked(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -368,6 +422,7 @@ public:
   GFXcanvas16(uint16_t w, uint16_t h);
   ~GFXcanvas16(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void writePixelUnchecked(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
   void byteSwap(void);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
@@ -68,6 +68,9 @@
 #include "freertos/FreeRTOS.h"
 #include <string.h>
 #endif
+#ifdef ARDUINO_ARCH_NATIVE
+#include "SimPanel.h"
+#endif
 
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
@@ -84,7 +87,8 @@
 // For similar reasons, the clock pin is only semi-configurable...it can
 // be specified as any pin within a specific PORT register stated below.
 
-#if defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+#if defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__) ||            \
+    defined(ARDUINO_ARCH_NATIVE)
 // Arduino Mega is now tested and confirmed, with the following caveats:
 // Because digital pins 2-7 don't map to a contiguous port register,
 // the Mega requires connecting the matrix data lines to different pins.
@@ -94,7 +98,7 @@
 // on the Mega, this CAN'T be pins 8 or 9 (these are on PORTH), thus the
 // wiring will need to be slightly different than the tutorial's
 // explanation on the Uno, etc.  Pins 10-13 are all fair game for the
-// clock, as are pins 50-53.
+// clock, as are pins 50-53.  The host-native build simulates a Mega.
 #define DATAPORT PORTA ///< RGB data PORT register
 #define DATADIR DDRA   ///< RGB data direction register
 #define CLKPORT PORTB  ///< RGB clock PORT register
@@ -117,7 +121,52 @@
 #define CLKPORT PORTB  ///< RGB clock PORT register
 #endif
 
-#define nPlanes 4 ///< Bit depth per R,G,B (4 = (2^4)^3 = 4096 colors)
+#define nPlanes RGBMATRIX_PLANES ///< Bit depth per R,G,B (4 = 4096 colors)
+
+// Frame buffer layout: each multiplexed row is stored as a run of WIDTH-
+// byte "plane rows", one byte per column, with the upper half's R,G,B
+// in bits 2-4 and the lower half's in bits 5-7 so they can be copied
+// straight to the 6 data lines.  With the default 4 planes, plane 0 is
+// scattered through the 2 least bits of the other three planes' bytes
+// ("packed", 3 bytes per column).  Any other depth stores every plane
+// alike, nPlanes bytes per column: less RAM and a lighter interrupt for
+// 1-3 planes, more colors (on 32-bit boards) for 5-6.  Built with
+// -D RGBMATRIX_UNPACKED, 4 planes are stored alike too: a third more RAM,
+// but plane 0 is issued as fast as the others instead of being unpacked
+// bit by bit (see updateDisplay()).
+#if (nPlanes < 1) || (nPlanes > 6)
+#error "RGBMATRIX_PLANES must be 1 to 6"
+#endif
+#if (nPlanes == 4) && !defined(RGBMATRIX_UNPACKED)
+#define PACKED 1     ///< Plane 0 scattered through the other planes' bytes
+#define nPlaneRows 3 ///< Plane rows per matrix row (4 planes packed in 3)
+#else
+#define PACKED 0           ///< Every plane in bytes of its own
+#define nPlaneRows nPlanes ///< Plane rows per matrix row
+#endif
+
+// Bits of RGBmatrixPanel::rowflags[].  ROW_DIRTY is set by every drawing
+// path.  When the back buffer is swapped out, its dirty rows become stale
+// in all the other buffers, i.e. those may differ from the newest frame
+// there; swapBuffers(true) copies just the stale rows into the new back
+// buffer.  A row the back buffer needs copying is dirty as far as
+// rowDirty() is concerned, stale or not.
+// ROW_BLANK(b) is set where the row is known to be all black in buffer b
+// (cleared by anything that may draw color there), so the refresh
+// interrupt can pass it by -- see setBlankRows().
+#define ROW_DIRTY 0x01             ///< Row drawn to since last swap
+#define ROW_STALE(b) (0x02 << (b)) ///< Buffer b lags newest frame here
+#define ROW_STALE_ALL 0x0E         ///< Stale bits for all 3 buffers
+#define ROW_BLANK(b) (0x10 << (b)) ///< Row all black in buffer b
+#define ROW_BLANK_ALL 0x70         ///< Blank bits for all 3 buffers
+
+#if defined(RGBMATRIX_STATS) && !(defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE))
+#error "RGBMATRIX_STATS needs Timer1 (AVR and host builds)"
+#endif
+#if defined(RGBMATRIX_PRESENT_LOG) &&                                          \
+    ((RGBMATRIX_PRESENT_LOG < 1) || (RGBMATRIX_PRESENT_LOG > 255))
+#error "RGBMATRIX_PRESENT_LOG must be 1 to 255"
+#endif
 
 // The fact that the display driver interrupt stuff is tied to the
 // singular Timer1 doesn't really take well to object orientation with
@@ -155,13 +204,15 @@ void RGBmatrixPanel::init(uint8_t rows, uint8_t a, uint8_t b, uint8_t c,
   nRows = rows; // Number of multiplexed rows; actual height is 2X this
 
   // Allocate and initialize matrix buffer:
-  int buffsize = width * nRows * 3, // x3 = 3 bytes holds 4 planes "packed"
+  int buffsize = width * nRows * nPlaneRows, // see layout notes above
       allocsize = (dbuf == true) ? (buffsize * 2) : buffsize;
   if (NULL == (matrixbuff[0] = (uint8_t *)malloc(allocsize)))
     return;
   memset(matrixbuff[0], 0, allocsize);
   // If not double-buffered, both buffers then point to the same address:
   matrixbuff[1] = (dbuf == true) ? &matrixbuff[0][buffsize] : matrixbuff[0];
+  matrixbuff[2] = matrixbuff[1]; // Only distinct if triple-buffered
+  nBuffers = (dbuf == true) ? 2 : 1;
 
   // Save pin numbers for use by begin() method later.
   _a = a;
@@ -184,10 +235,54 @@ void RGBmatrixPanel::init(uint8_t rows, uint8_t a, uint8_t b, uint8_t c,
   addrbmask = digitalPinToBitMask(b);
   addrcport = portOutputRegister(digitalPinToPort(c));
   addrcmask = digitalPinToBitMask(c);
+  addrdelay = 10;
+  brightness = 255;
+  calsamples = 0;
+  lockfps = 0.0;
+  rowticks = 0;
+  framepad = 0;
+  syncpin = -1;
+  syncwindow = 100;
+  frameus = 0;
+  framestart = 0;
+  memset(&sync, 0, sizeof sync);
   plane = nPlanes - 1;
   row = nRows - 1;
   swapflag = false;
-  backindex = 0; // Array index of back buffer
+  backindex = 0;   // Array index of back buffer
+  frontindex = 1;  // Array index of front buffer
+  readyindex = 1;  // Nothing queued until swapflag is set
+  latestindex = 1; // Front buffer holds the newest (blank) frame
+  memset(rowflags, ROW_BLANK_ALL, sizeof rowflags); // Cleared, identical
+  memset(rowoffset, 0, sizeof rowoffset); // Not scrolled
+  memset(ditherbuff, 0, sizeof ditherbuff); // Not dithered
+  dither = false;
+  ditherphase = false;
+  blankrows = BLANK_ROWS_SCAN;
+  loadblank = false;
+  showblank = false;
+  pattern = NULL;
+  scanpattern = NULL;
+  patternframe = 0;
+  patternrow = NULL;
+  patterncolors = NULL;
+  scanoffset = 0;
+  copybytes = 0;
+  copytotal = 0;
+  swapcopy = false;
+  swapcallback = NULL;
+  swapport = NULL;
+  swapmask = 0;
+  frameshown = 0;
+  framedrops = 0;
+#if defined(RGBMATRIX_PRESENT_LOG)
+  presenthead = 0;
+  presentcount = 0;
+  presentlost = 0;
+#endif
+#if defined(RGBMATRIX_STATS)
+  memset(&stats, 0, sizeof stats);
+#endif
 }
 
 // Constructor for 16x32 panel:
@@ -270,9 +365,12 @@ IRAM_ATTR void IRQ_HANDLER(void *);
 
 void RGBmatrixPanel::begin(void) {
 
-  backindex = 0;                       // Back buffer
-  buffptr = matrixbuff[1 - backindex]; // -> front buffer
+  backindex = 0;                      // Back buffer
+  frontindex = 1;                     // Front buffer
+  buffptr = matrixbuff[frontindex];   // -> front buffer
+  scanbuff = matrixbuff[frontindex];
   activePanel = this;                  // For interrupt hander
+  resetPlaneTimes();
 
   // Enable all comm & address pins as outputs, set default states:
   pinMode(_clk, OUTPUT);
@@ -296,7 +394,23 @@ void RGBmatrixPanel::begin(void) {
     *addreport &= ~addremask; // Low
   }
 
-#if defined(__AVR__)
+  // If the address pins all share a PORT, rows are selected in one write
+  addrport = addraport;
+  addrmask = addramask | addrbmask | addrcmask;
+  if ((addrbport != addraport) || (addrcport != addraport))
+    addrport = NULL;
+  if (nRows > 8) {
+    addrmask |= addrdmask;
+    if (addrdport != addraport)
+      addrport = NULL;
+  }
+  if (nRows > 16) {
+    addrmask |= addremask;
+    if (addreport != addraport)
+      addrport = NULL;
+  }
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
 
   // The high six bits of the data port are set as outputs;
   // Might make this configurable in the future, but not yet.
@@ -394,13 +508,25 @@ void RGBmatrixPanel::begin(void) {
   timer_start(TIMER_GROUP_1, TIMER_0);
 #endif
 
-#if defined(__AVR__)
+#if defined(ARDUINO_ARCH_NATIVE)
+  // Attach the simulated panel, which decodes what updateDisplay() sends
+  // into images (see lib/ArduinoNative).
+  const uint8_t addrpins[] = {_a, _b, _c, _d, _e};
+  simPanel.begin(WIDTH, nRows, &DATAPORT, _clk, _lat, _oe, addrpins);
+#endif
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
   // Set up Timer1 for interrupt:
   TCCR1A = _BV(WGM11);                          // Mode 14 (fast PWM), OC1A off
   TCCR1B = _BV(WGM13) | _BV(WGM12) | _BV(CS10); // Mode 14, no prescale
   ICR1 = 100;
   TIMSK1 |= _BV(TOIE1); // Enable Timer1 interrupt
+  setBrightness(brightness); // Compare B interrupt too, if dimmed
   sei();                // Enable global interrupts
+#if defined(__AVR__)
+  calibrate(); // Host timings aren't an AVR's: the constants stand there
+#endif
+  lockRefreshRate(lockfps);
 #endif
 
 #if defined(ARDUINO_ARCH_SAMD)
@@ -501,6 +627,70 @@ void RGBmatrixPanel::begin(void) {
 #endif // ARDUINO_ARCH_SAMD
 }
 
+// The buffer block from init() is grown in place to three buffers.  The
+// back buffer keeps slot 0 and the front buffer slot 1, as in begin();
+// slot 2 starts out as a copy of the (identical) pair, so all three hold
+// the newest frame and no rows are stale.
+static boolean tripleBuffers(uint8_t *bufs[3], uint8_t n, int buffsize) {
+  uint8_t *buf;
+
+  if (NULL == (buf = (uint8_t *)realloc(bufs[0], buffsize * 3)))
+    return false;
+  if (n == 1) // Back buffer was also the front buffer
+    memcpy(&buf[buffsize], buf, buffsize);
+  memcpy(&buf[buffsize * 2], &buf[buffsize], buffsize);
+  bufs[0] = buf;
+  bufs[1] = &buf[buffsize];
+  bufs[2] = &buf[buffsize * 2];
+  return true;
+}
+
+// Dithered, the alternate images' block is grown the same way.  Once
+// begin() has run, the refresh interrupt holds pointers into the block
+// (scanbuff, buffptr) that realloc() may free, so it's too late then.
+boolean RGBmatrixPanel::enableTripleBuffering(void) {
+  int buffsize = WIDTH * nRows * nPlaneRows;
+
+  if (nBuffers == 3)
+    return true;
+  if (!matrixbuff[0] || (activePanel == this)) // Released, or being shown
+    return false;
+  if (!tripleBuffers(matrixbuff, nBuffers, buffsize))
+    return false;
+  if (ditherbuff[0] && !tripleBuffers(ditherbuff, nBuffers, buffsize)) {
+    matrixbuff[2] = matrixbuff[1] = matrixbuff[nBuffers - 1]; // As before
+    return false;
+  }
+  rowoffset[2] = rowoffset[1];
+  for (uint8_t r = 0; r < nRows; r++) // Black where slot 1 is
+    rowflags[r] =
+        (rowflags[r] & ~ROW_BLANK(2)) | ((rowflags[r] & ROW_BLANK(1)) << 1);
+  nBuffers = 3;
+  return true;
+}
+
+// The alternate images start out as copies of the buffers: nothing drawn
+// so far has a dither bit.  They're laid out alike, in a block of their
+// own, and once allocated are kept up to date even while dithering is
+// off, so it can be switched on again without a redraw.
+boolean RGBmatrixPanel::setDither(boolean on) {
+  int buffsize = WIDTH * nRows * nPlaneRows;
+  uint8_t *buf;
+
+  if (!matrixbuff[0]) // Released
+    return false;
+  if (on && !ditherbuff[0]) {
+    if ((nPlanes > 5) ||
+        (NULL == (buf = (uint8_t *)malloc(buffsize * nBuffers))))
+      return false;
+    memcpy(buf, matrixbuff[0], buffsize * nBuffers);
+    for (uint8_t i = 0; i < 3; i++)
+      ditherbuff[i] = &buf[matrixbuff[i] - matrixbuff[0]];
+  }
+  dither = on; // Takes effect at the next frame
+  return true;
+}
+
 // Original RGBmatrixPanel library used 3/3/3 color.  Later version used
 // 4/4/4.  Then Adafruit_GFX (core library used across all Adafruit
 // display devices now) standardized on 5/6/5.  The matrix still operates
@@ -619,7 +809,7 @@ void RGBmatrixPanel::DrawString_CN( uint8_t Xstart, uint8_t Ystart, const char *
   uint8_t bit, shift_x = 0, shift_y;
   uint16_t arr_sum;
   int x = Xstart, y = Ystart;
-  const unsigned char* p_text = pString;
+  const unsigned char* p_text = (const unsigned char *)pString;
   while (*p_text != 0) {
     for (int Num = 0; Num < font->size ; Num++) {
       if ((*p_text == pgm_read_byte(&font->table[Num].index[0])) && (*(p_text + 1) == pgm_read_byte(&font->table[Num].index[1])) && (*(p_text + 2) == pgm_read_byte(&font->table[Num].index[2]))) 
@@ -695,52 +885,90 @@ void RGBmatrixPanel::DrawString_CN( uint8_t Xstart, uint8_t Ystart, const char *
   }
 }
 
-void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, uint16_t c) {
-  uint8_t r, g, b, bit, limit, *ptr;
+// Adafruit_GFX uses 16-bit color in 5/6/5 format, while matrix needs
+// nPlanes bits per R,G,B.  Pluck out relevant bits while separating:
+static inline void splitColor(uint16_t c, uint8_t *r, uint8_t *g,
+                              uint8_t *b) {
+#if nPlanes <= 5
+  *r = c >> (16 - nPlanes);                          // RRRRrggggggbbbbb
+  *g = (c >> (11 - nPlanes)) & ((1 << nPlanes) - 1); // rrrrrGGGGggbbbbb
+  *b = (c >> (5 - nPlanes)) & ((1 << nPlanes) - 1);  // rrrrrggggggBBBBb
+#else
+  // 6 bits: green as-is, red and blue widened by repeating their MSB
+  *r = ((c >> 10) & 0x3E) | (c >> 15);
+  *g = (c >> 5) & 0x3F;
+  *b = ((c << 1) & 0x3E) | ((c >> 4) & 1);
+#endif
+}
 
-  if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height))
-    return;
+// With dithering (see setDither()), every pixel is also drawn in an
+// alternate image, shown every other frame, one level up from the one
+// splitColor() truncates to wherever the first 5/6/5 bit cut off is set
+// (unless already at full scale).  The two frames average out to half a
+// level in between.
+static uint16_t ditherColor(uint16_t c) {
+#if nPlanes <= 5
+  uint8_t r, g, b, top = (1 << nPlanes) - 1;
+
+  splitColor(c, &r, &g, &b);
+#if nPlanes < 5
+  if ((c & (1 << (15 - nPlanes))) && (r < top))
+    r++;
+  if ((c & (1 << (4 - nPlanes))) && (b < top))
+    b++;
+#endif
+  if ((c & (1 << (10 - nPlanes))) && (g < top))
+    g++;
+  return ((uint16_t)r << (16 - nPlanes)) | ((uint16_t)g << (11 - nPlanes)) |
+         ((uint16_t)b << (5 - nPlanes));
+#else
+  return c; // Nothing cut off to dither
+#endif
+}
 
-  switch (rotation) {
-  case 1:
-    _swap_int16_t(x, y);
-    x = WIDTH - 1 - x;
-    break;
-  case 2:
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
-    break;
-  case 3:
-    _swap_int16_t(x, y);
-    y = HEIGHT - 1 - y;
-    break;
-  }
+// scrollRows() turns each half of the display into a ring of nRows
+// buffer rows, rotated by rowoffset[]: matrix row y (and y + nRows) is
+// held in buffer row y + rowoffset[], wrapping around.
+inline uint8_t RGBmatrixPanel::bufferRow(int16_t y) {
+  uint8_t r = ((y < nRows) ? y : (y - nRows)) + rowoffset[backindex];
+
+  return (r < nRows) ? r : (r - nRows);
+}
+
+// Without double buffering, the back buffer is also the front buffer
+// (under every index), so its ROW_BLANK bits all go together.
+inline uint8_t RGBmatrixPanel::backBlank(void) {
+  return (nBuffers == 1) ? ROW_BLANK_ALL : ROW_BLANK(backindex);
+}
 
-  // Adafruit_GFX uses 16-bit color in 5/6/5 format, while matrix needs
-  // 4/4/4.  Pluck out relevant bits while separating into R,G,B:
-  r = c >> 12 ;        // RRRRrggggggbbbbb
-  g = (c >> 7) & 0xF; // rrrrrGGGGggbbbbb
-  b = (c >> 1) & 0xF; // rrrrrggggggBBBBb
+// Store one pixel's components in the plane bytes of its column: 'ptr'
+// is the column's first byte within the multiplexed row, 'lower' selects
+// the lower half of the display.
+static inline void writeColumn(uint8_t *ptr, int16_t width, boolean lower,
+                               uint8_t r, uint8_t g, uint8_t b) {
+  uint8_t bit, limit;
+#if !PACKED
+  uint8_t shift, v;
+#endif
 
   // Loop counter stuff
-  bit = 2;
   limit = 1 << nPlanes;
 
-  if (y < nRows) {
+#if PACKED
+  bit = 2;
+  if (!lower) {
     // Data for the upper half of the display is stored in the lower
-    // bits of each byte.
-    ptr = &matrixbuff[backindex][y * WIDTH * (nPlanes - 1) + x]; // Base addr
-    // Plane 0 is a tricky case -- its data is spread about,
-    // stored in least two bits not used by the other planes.
-    ptr[WIDTH * 2] &= ~B00000011; // Plane 0 R,G mask out in one op
+    // bits of each byte.  Plane 0 is a tricky case -- its data is spread
+    // about, stored in least two bits not used by the other planes.
+    ptr[width * 2] &= ~B00000011; // Plane 0 R,G mask out in one op
     if (r & 1)
-      ptr[WIDTH * 2] |= B00000001; // Plane 0 R: 64 bytes ahead, bit 0
+      ptr[width * 2] |= B00000001; // Plane 0 R: 64 bytes ahead, bit 0
     if (g & 1)
-      ptr[WIDTH * 2] |= B00000010; // Plane 0 G: 64 bytes ahead, bit 1
+      ptr[width * 2] |= B00000010; // Plane 0 G: 64 bytes ahead, bit 1
     if (b & 1)
-      ptr[WIDTH] |= B00000001; // Plane 0 B: 32 bytes ahead, bit 0
+      ptr[width] |= B00000001; // Plane 0 B: 32 bytes ahead, bit 0
     else
-      ptr[WIDTH] &= ~B00000001; // Plane 0 B unset; mask out
+      ptr[width] &= ~B00000001; // Plane 0 B unset; mask out
     // The remaining three image planes are more normal-ish.
     // Data is stored in the high 6 bits so it can be quickly
     // copied to the DATAPORT register w/6 output lines.
@@ -752,17 +980,16 @@ void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, uint16_t c) {
         *ptr |= B00001000; // Plane N G: bit 3
       if (b & bit)
         *ptr |= B00010000; // Plane N B: bit 4
-      ptr += WIDTH;        // Advance to next bit plane
+      ptr += width;        // Advance to next bit plane
     }
   } else {
     // Data for the lower half of the display is stored in the upper
     // bits, except for the plane 0 stuff, using 2 least bits.
-    ptr = &matrixbuff[backindex][(y - nRows) * WIDTH * (nPlanes - 1) + x];
     *ptr &= ~B00000011; // Plane 0 G,B mask out in one op
     if (r & 1)
-      ptr[WIDTH] |= B00000010; // Plane 0 R: 32 bytes ahead, bit 1
+      ptr[width] |= B00000010; // Plane 0 R: 32 bytes ahead, bit 1
     else
-      ptr[WIDTH] &= ~B00000010; // Plane 0 R unset; mask out
+      ptr[width] &= ~B00000010; // Plane 0 R unset; mask out
     if (g & 1)
       *ptr |= B00000001; // Plane 0 G: bit 0
     if (b & 1)
@@ -775,25 +1002,710 @@ void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, uint16_t c) {
         *ptr |= B01000000; // Plane N G: bit 6
       if (b & bit)
         *ptr |= B10000000; // Plane N B: bit 7
-      ptr += WIDTH;        // Advance to next bit plane
+      ptr += width;        // Advance to next bit plane
     }
   }
+#else
+  // Without packing, all planes are alike: R,G,B in bits 2-4 (upper half)
+  // or 5-7 (lower half) of one byte per column.
+  shift = lower ? 5 : 2;
+  for (bit = 1; bit < limit; bit <<= 1) {
+    v = ((r & bit) ? 1 : 0) | ((g & bit) ? 2 : 0) | ((b & bit) ? 4 : 0);
+    *ptr = (*ptr & ~(B00000111 << shift)) | (v << shift);
+    ptr += width; // Advance to next bit plane
+  }
+#endif
 }
 
-void RGBmatrixPanel::fillScreen(uint16_t c) {
-  if ((c == 0x0000) || (c == 0xffff)) {
-    // For black or white, all bits in frame buffer will be identically
-    // set or unset (regardless of weird bit packing), so it's OK to just
-    // quickly memset the whole thing:
-    memset(matrixbuff[backindex], c, WIDTH * nRows * 3);
+void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, uint16_t c) {
+  if (inClip(x, y))
+    RGBmatrixPanel::writePixelUnchecked(x, y, c);
+}
+
+void RGBmatrixPanel::writePixelUnchecked(int16_t x, int16_t y, uint16_t c) {
+  uint8_t r, g, b, line, *ptr;
+  uint16_t offset;
+
+  if (!matrixbuff[0])
+    return;
+
+  switch (rotation) {
+  case 1:
+    _swap_int16_t(x, y);
+    x = WIDTH - 1 - x;
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+  case 3:
+    _swap_int16_t(x, y);
+    y = HEIGHT - 1 - y;
+    break;
+  }
+
+  line = bufferRow(y);
+  rowflags[line] |= ROW_DIRTY;
+  if (c)
+    rowflags[line] &= ~backBlank();
+  offset = line * WIDTH * nPlaneRows + x;
+  splitColor(c, &r, &g, &b);
+  writeColumn(&matrixbuff[backindex][offset], WIDTH, y >= nRows, r, g, b);
+  if ((ptr = ditherbuff[backindex])) { // Next level up, where dithered
+    splitColor(ditherColor(c), &r, &g, &b);
+    writeColumn(&ptr[offset], WIDTH, y >= nRows, r, g, b);
+  }
+}
+
+// Inverse of splitColor(): widen an n-bit component to 'bits' bits by
+// repeating it below itself, as Color444() does for 4 bits.
+static inline uint8_t widenColor(uint8_t v, uint8_t n, uint8_t bits) {
+  uint8_t w = 0;
+
+  for (int8_t s = bits - n; s > -n; s -= n)
+    w |= (s >= 0) ? (v << s) : (v >> -s);
+  return w;
+}
+
+// Reassemble one pixel's components from the plane bytes of its column:
+// 'ptr' is the column's first byte within the multiplexed row, 'shift' 2
+// for the upper half or 5 for the lower.  Plane 0 is unpacked as the
+// interrupt handler does.
+static inline void readPlanes(const uint8_t *ptr, int16_t width,
+                              uint8_t shift, uint8_t *r, uint8_t *g,
+                              uint8_t *b) {
+  uint8_t p, v;
+
+  *r = *g = *b = 0;
+  for (p = 0; p < nPlanes; p++) {
+#if PACKED
+    if (p == 0)
+      v = (ptr[0] << 6) | ((ptr[width] << 4) & 0x30) |
+          ((ptr[width * 2] << 2) & 0x0C);
+    else
+      v = ptr[(p - 1) * width];
+#else
+    v = ptr[p * width];
+#endif
+    v >>= shift;
+    *r |= (v & 1) << p;
+    *g |= ((v >> 1) & 1) << p;
+    *b |= ((v >> 2) & 1) << p;
+  }
+}
+
+// The 5/6/5 color of a column read with readPlanes().  If dithered, 'alt'
+// is the same column in the alternate image: a component a level up
+// there has the next bit down set.
+static inline uint16_t readColumn(const uint8_t *ptr, const uint8_t *alt,
+                                  int16_t width, uint8_t shift) {
+  uint8_t r, g, b, r2, g2, b2, n = nPlanes;
+
+  readPlanes(ptr, width, shift, &r, &g, &b);
+  if (alt) {
+    readPlanes(alt, width, shift, &r2, &g2, &b2);
+    r = (r << 1) | (r2 != r);
+    g = (g << 1) | (g2 != g);
+    b = (b << 1) | (b2 != b);
+    n++;
+  }
+
+  return ((uint16_t)widenColor(r, n, 5) << 11) | (widenColor(g, n, 6) << 5) |
+         widenColor(b, n, 5);
+}
+
+uint16_t RGBmatrixPanel::getPixel(int16_t x, int16_t y) {
+  if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height) ||
+      !matrixbuff[0])
+    return 0;
+
+  // Same mapping as drawPixel()
+  switch (rotation) {
+  case 1:
+    _swap_int16_t(x, y);
+    x = WIDTH - 1 - x;
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+  case 3:
+    _swap_int16_t(x, y);
+    y = HEIGHT - 1 - y;
+    break;
+  }
+
+  uint16_t offset = bufferRow(y) * WIDTH * nPlaneRows + x;
+  uint8_t *alt = ditherbuff[backindex];
+
+  return readColumn(&matrixbuff[backindex][offset],
+                    alt ? &alt[offset] : NULL, WIDTH, (y < nRows) ? 2 : 5);
+}
+
+void RGBmatrixPanel::readRow(int16_t y, uint16_t *colors) {
+  uint8_t *ptr, *alt, shift;
+  uint16_t offset;
+
+  if ((y < 0) || (y >= HEIGHT))
+    return;
+  if (!matrixbuff[0]) { // Released: nothing to read back
+    memset(colors, 0, WIDTH * sizeof(uint16_t));
+    return;
+  }
+
+  offset = bufferRow(y) * WIDTH * nPlaneRows;
+  ptr = &matrixbuff[backindex][offset];
+  alt = ditherbuff[backindex] ? &ditherbuff[backindex][offset] : NULL;
+  shift = (y < nRows) ? 2 : 5;
+  for (int16_t x = 0; x < WIDTH; x++)
+    colors[x] = readColumn(&ptr[x], alt ? &alt[x] : NULL, WIDTH, shift);
+}
+
+// Same bit assignments as drawPixel(), but computed once per color so
+// that spans can be written without repeating the 5/6/5 split for every
+// pixel.  For each of the nPlaneRows bytes that hold a column's data
+// within a row, 'mask' flags the bits that belong to the given half of
+// the display and 'bits' holds their new state.
+static void planeBits(uint16_t c, boolean lower, uint8_t *bits,
+                      uint8_t *mask) {
+  uint8_t r, g, b, i, n;
+
+  splitColor(c, &r, &g, &b);
+
+  // R,G,B in bits 2-4 (upper half) or 5-7 (lower half) -- planes 1-3
+  // when packed, else all planes in order.
+  for (i = 0; i < nPlaneRows; i++) {
+    n = PACKED ? i + 1 : i;
+    bits[i] = ((r >> n) & 1) | (((g >> n) & 1) << 1) | (((b >> n) & 1) << 2);
+    if (lower) {
+      bits[i] <<= 5;
+      mask[i] = B11100000;
+    } else {
+      bits[i] <<= 2;
+      mask[i] = B00011100;
+    }
+  }
+
+#if PACKED
+  // Plane 0 is scattered through the two least bits of all three bytes
+  if (lower) {
+    mask[0] |= B00000011; // G in bit 0, B in bit 1
+    bits[0] |= (g & 1) | ((b & 1) << 1);
+    mask[1] |= B00000010; // R in bit 1
+    bits[1] |= (r & 1) << 1;
   } else {
-    // Otherwise, need to handle it the long way:
-    Adafruit_GFX::fillScreen(c);
+    mask[1] |= B00000001; // B in bit 0
+    bits[1] |= b & 1;
+    mask[2] |= B00000011; // R in bit 0, G in bit 1
+    bits[2] |= (r & 1) | ((g & 1) << 1);
+  }
+#endif
+}
+
+// Two 5/6/5 colors are converted at once, packed in one word (the first
+// in the low half).  Each component's bits sit at a fixed distance from
+// the others', so once a plane's bit of B is shifted to bit 0 of each
+// half, G's is in bit 6 and R's in bit 11, and planeGather() picks them
+// out into bits 0-2 (as planeBits() orders them) for both colors
+// together.  The next plane is then a shift right away.  No bit ever
+// crosses from one half of the word into the other.
+static inline uint32_t planeGather(uint32_t p) {
+  return ((p >> 11) & 0x00010001) | ((p >> 5) & 0x00020002) |
+         ((p << 2) & 0x00040004);
+}
+
+// Colors are converted two columns at a time, as above, and merged into
+// the column bytes under the half's masks, leaving the partner row's
+// bits in place.  Only one half is seen here, so a black row doesn't
+// become blank.
+void RGBmatrixPanel::writeSpan(int16_t x, int16_t y, int16_t w,
+                               const uint16_t *colors) {
+  uint8_t bits[nPlaneRows], mask[nPlaneRows], line, i, k, shift, *ptr;
+  uint8_t *image[2] = {matrixbuff[backindex], ditherbuff[backindex]};
+  boolean lower = (y >= nRows), lit = false;
+  uint32_t p, v0, v[nPlaneRows];
+  uint16_t c0, c1;
+  int16_t n;
+
+  planeBits(0, lower, bits, mask); // Which bits are this half's
+  shift = lower ? 5 : 2;
+  line = bufferRow(y);
+  for (k = 0; (k < 2) && image[k]; k++) {
+    ptr = &image[k][line * WIDTH * nPlaneRows + x];
+    for (n = 0; n < w; n += 2, ptr += 2) {
+      c0 = colors[n];
+      c1 = (n + 1 < w) ? colors[n + 1] : 0;
+      if (c0 | c1)
+        lit = true;
+      if (k) { // Alternate image, next level up
+        c0 = ditherColor(c0);
+        c1 = ditherColor(c1);
+      }
+      p = c0 | ((uint32_t)c1 << 16);
+#if nPlanes == 6
+      // Red and blue widened by their top bit (see splitColor()): plane 0
+      // is picked out on its own, the others line up from plane 1 on
+      v0 = ((p >> 15) & 0x00010001) | ((p >> 4) & 0x00020002) |
+           ((p >> 2) & 0x00040004);
+#else
+      p >>= 5 - nPlanes; // Plane 0 lined up
+      v0 = planeGather(p);
+      p >>= 1;
+#endif
+      i = 0;
+#if !PACKED
+      v[i++] = v0 << shift;
+#endif
+      for (; i < nPlaneRows; i++, p >>= 1)
+        v[i] = planeGather(p) << shift;
+#if PACKED
+      // Plane 0 is scattered through the two least bits (see planeBits())
+      if (lower) {
+        v[0] |= (v0 >> 1) & 0x00030003; // G in bit 0, B in bit 1
+        v[1] |= (v0 << 1) & 0x00020002; // R in bit 1
+      } else {
+        v[1] |= (v0 >> 2) & 0x00010001; // B in bit 0
+        v[2] |= v0 & 0x00030003;        // R in bit 0, G in bit 1
+      }
+#endif
+      for (i = 0; i < nPlaneRows; i++) {
+        ptr[i * WIDTH] = (ptr[i * WIDTH] & ~mask[i]) | (uint8_t)v[i];
+        if (n + 1 < w)
+          ptr[i * WIDTH + 1] =
+              (ptr[i * WIDTH + 1] & ~mask[i]) | (uint8_t)(v[i] >> 16);
+      }
+    }
   }
+  rowflags[line] |= ROW_DIRTY;
+  if (lit)
+    rowflags[line] &= ~backBlank();
 }
 
-// Return address of back buffer -- can then load/store data directly
-uint8_t *RGBmatrixPanel::backBuffer() { return matrixbuff[backindex]; }
+void RGBmatrixPanel::writeRow(int16_t y, const uint16_t *colors) {
+  if ((y >= 0) && (y < HEIGHT))
+    writeSpan(0, y, WIDTH, colors);
+}
+
+// Clipped once, in screen coordinates; the clipped area then maps to a
+// rectangle of matrix rows and columns, which is written a row at a
+// time.  Walking along a matrix row steps through the image along a row
+// (rotation 0 or 2) or a column (1 or 3), so its pixels are gathered
+// into a span first -- except for a 16-bit image at rotation 0, whose
+// rows are passed on as they are.
+void RGBmatrixPanel::blit(int16_t x, int16_t y, int16_t w, int16_t h,
+                          const uint16_t *pixels, const uint8_t *bitmap,
+                          uint16_t color, uint16_t bg) {
+  int16_t x0 = max(x, clip_x0), y0 = max(y, clip_y0),
+          x1 = min((int16_t)(x + w), clip_x1),
+          y1 = min((int16_t)(y + h), clip_y1), bx, by, bw, bh, cx, cy, dcx,
+          dcy, i, j, pitch = (w + 7) / 8;
+  uint16_t span[64]; // Widest matrix (see the 'pew' loop in updateDisplay())
+
+  if ((x0 >= x1) || (y0 >= y1))
+    return;
+
+  // Matrix rectangle bx,by,bw,bh, and the image pixel cx,cy at its top
+  // left, moving by dcx,dcy along a matrix row (see drawPixel())
+  switch (rotation) {
+  case 0:
+    bx = x0;
+    by = y0;
+    bw = x1 - x0;
+    bh = y1 - y0;
+    cx = x0 - x;
+    cy = y0 - y;
+    dcx = 1;
+    dcy = 0;
+    break;
+  case 1:
+    bx = WIDTH - y1;
+    by = x0;
+    bw = y1 - y0;
+    bh = x1 - x0;
+    cx = x0 - x;
+    cy = y1 - 1 - y;
+    dcx = 0;
+    dcy = -1;
+    break;
+  case 2:
+    bx = WIDTH - x1;
+    by = HEIGHT - y1;
+    bw = x1 - x0;
+    bh = y1 - y0;
+    cx = x1 - 1 - x;
+    cy = y1 - 1 - y;
+    dcx = -1;
+    dcy = 0;
+    break;
+  default:
+    bx = y0;
+    by = HEIGHT - x1;
+    bw = y1 - y0;
+    bh = x1 - x0;
+    cx = x1 - 1 - x;
+    cy = y0 - y;
+    dcx = 0;
+    dcy = 1;
+    break;
+  }
+
+  for (j = 0; j < bh; j++) {
+    if (pixels && (rotation == 0)) {
+      writeSpan(bx, by + j, bw, &pixels[(cy + j) * w + cx]);
+      continue;
+    }
+    // Down the matrix, the image moves at right angles to dcx,dcy
+    int16_t px = cx - dcy * j, py = cy + dcx * j;
+    for (i = 0; i < bw; i++, px += dcx, py += dcy) {
+      if (pixels)
+        span[i] = pixels[py * w + px];
+      else
+        span[i] = (bitmap[py * pitch + px / 8] & (0x80 >> (px & 7))) ? color
+                                                                   : bg;
+    }
+    writeSpan(bx, by + j, bw, span);
+  }
+}
+
+void RGBmatrixPanel::drawCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas) {
+  uint8_t r = canvas->getRotation() & 1;
+
+  if (canvas->getBuffer())
+    blit(x, y, r ? canvas->height() : canvas->width(),
+         r ? canvas->width() : canvas->height(), canvas->getBuffer(), NULL,
+         0, 0);
+}
+
+void RGBmatrixPanel::drawCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas,
+                                uint16_t color, uint16_t bg) {
+  uint8_t r = canvas->getRotation() & 1;
+
+  if (canvas->getBuffer())
+    blit(x, y, r ? canvas->height() : canvas->width(),
+         r ? canvas->width() : canvas->height(), NULL, canvas->getBuffer(),
+         color, bg);
+}
+
+// Walks the multiplexed rows rather than display rows: where the
+// rectangle covers both a row in the upper half and its partner in the
+// lower half, the two sets of bits are merged so each byte is written
+// once.  The masks then span the whole byte (when packed -- otherwise the
+// 2 least bits, unused, are zeroed), and the read-modify-write collapses
+// to a memset per plane -- so full-height bands (and the whole screen)
+// fill at memset speed in any color.  If dithered, the alternate image
+// is filled alongside in its own color.  Rows filled black right across
+// become blank.
+void RGBmatrixPanel::fillRawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t c) {
+  uint8_t bits[2][2][nPlaneRows], mask[2][nPlaneRows], row, l, i, k, m, v,
+      *ptr;
+  uint8_t *image[2] = {matrixbuff[backindex], ditherbuff[backindex]};
+  uint8_t off = rowoffset[backindex], blank = backBlank();
+  boolean upper, lower;
+  int16_t n;
+
+  planeBits(c, false, bits[0][0], mask[0]);
+  planeBits(c, true, bits[0][1], mask[1]);
+  if (image[1]) {
+    planeBits(ditherColor(c), false, bits[1][0], mask[0]);
+    planeBits(ditherColor(c), true, bits[1][1], mask[1]);
+  }
+
+  for (row = 0; row < nRows; row++) {
+    l = (row >= off) ? (row - off) : (row + nRows - off); // As scrolled
+    upper = (l >= y) && (l < y + h);
+    lower = (l + nRows >= y) && (l + nRows < y + h);
+    if (!upper && !lower)
+      continue;
+    rowflags[row] |= ROW_DIRTY;
+    if (c)
+      rowflags[row] &= ~blank;
+    else if (upper && lower && (w == WIDTH))
+      rowflags[row] |= blank;
+    for (k = 0; (k < 2) && image[k]; k++) {
+      ptr = &image[k][row * WIDTH * nPlaneRows + x];
+      for (i = 0; i < nPlaneRows; i++) {
+        m = (upper ? mask[0][i] : 0) | (lower ? mask[1][i] : 0);
+        v = (upper ? bits[k][0][i] : 0) | (lower ? bits[k][1][i] : 0);
+        if ((m | B00000011) == 0xFF) {
+          memset(ptr, v, w);
+        } else {
+          m = ~m;
+          for (n = 0; n < w; n++)
+            ptr[n] = (ptr[n] & m) | v;
+        }
+        ptr += WIDTH; // Advance to next bit plane
+      }
+    }
+  }
+}
+
+void RGBmatrixPanel::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                              uint16_t c) {
+  int16_t t;
+
+  if (w < 0) { // Convert negative sizes to positive equivalent
+    w = -w;
+    x -= w - 1;
+  }
+  if (h < 0) {
+    h = -h;
+    y -= h - 1;
+  }
+
+  // Clip to the clip rectangle (the whole display unless set) once for
+  // the whole rectangle
+  if (x < clip_x0) {
+    w -= clip_x0 - x;
+    x = clip_x0;
+  }
+  if (y < clip_y0) {
+    h -= clip_y0 - y;
+    y = clip_y0;
+  }
+  if (x + w > clip_x1)
+    w = clip_x1 - x;
+  if (y + h > clip_y1)
+    h = clip_y1 - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  // Then map it to unrotated matrix coordinates, as drawPixel() does:
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = WIDTH - y - h;
+    y = t;
+    _swap_int16_t(w, h);
+    break;
+  case 2:
+    x = WIDTH - x - w;
+    y = HEIGHT - y - h;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = HEIGHT - t - w;
+    _swap_int16_t(w, h);
+    break;
+  }
+
+  fillRawRect(x, y, w, h, c);
+}
+
+// Same walk as fillRawRect(), moving bytes instead of setting them: where
+// a multiplexed row is covered in both halves, every bit of its plane
+// bytes moves (memmove); otherwise only the half's own bits do.  Both
+// images move alike if dithered.
+void RGBmatrixPanel::scrollRawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   int16_t dx) {
+  uint8_t bits[nPlaneRows], mask[2][nPlaneRows], row, l, i, k, m, *ptr, *dst,
+      *src;
+  uint8_t *image[2] = {matrixbuff[backindex], ditherbuff[backindex]};
+  uint8_t off = rowoffset[backindex];
+  boolean upper, lower;
+  int16_t n;
+
+  // Which bits belong to each half doesn't depend on the color
+  planeBits(0, false, bits, mask[0]);
+  planeBits(0, true, bits, mask[1]);
+
+  w -= abs(dx); // Columns that move
+  for (row = 0; row < nRows; row++) {
+    l = (row >= off) ? (row - off) : (row + nRows - off); // As scrolled
+    upper = (l >= y) && (l < y + h);
+    lower = (l + nRows >= y) && (l + nRows < y + h);
+    if (!upper && !lower)
+      continue;
+    rowflags[row] |= ROW_DIRTY;
+    for (k = 0; (k < 2) && image[k]; k++) {
+      ptr = &image[k][row * WIDTH * nPlaneRows + x];
+      dst = (dx < 0) ? ptr : ptr + dx;
+      src = (dx < 0) ? ptr - dx : ptr;
+      for (i = 0; i < nPlaneRows; i++) {
+        m = (upper ? mask[0][i] : 0) | (lower ? mask[1][i] : 0);
+        if ((m | B00000011) == 0xFF) {
+          memmove(dst, src, w);
+        } else if (dx < 0) { // Copy in the direction of the move
+          for (n = 0; n < w; n++)
+            dst[n] = (dst[n] & ~m) | (src[n] & m);
+        } else {
+          for (n = w - 1; n >= 0; n--)
+            dst[n] = (dst[n] & ~m) | (src[n] & m);
+        }
+        dst += WIDTH; // Advance to next bit plane
+        src += WIDTH;
+      }
+    }
+  }
+}
+
+void RGBmatrixPanel::scrollRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                int16_t dx, uint16_t c) {
+  int16_t i, j;
+
+  if (w < 0) { // Convert negative sizes to positive equivalent
+    w = -w;
+    x -= w - 1;
+  }
+  if (h < 0) {
+    h = -h;
+    y -= h - 1;
+  }
+
+  // Clip as fillRect() does
+  if (x < clip_x0) {
+    w -= clip_x0 - x;
+    x = clip_x0;
+  }
+  if (y < clip_y0) {
+    h -= clip_y0 - y;
+    y = clip_y0;
+  }
+  if (x + w > clip_x1)
+    w = clip_x1 - x;
+  if (y + h > clip_y1)
+    h = clip_y1 - y;
+  if ((w <= 0) || (h <= 0) || (dx == 0))
+    return;
+
+  if ((dx <= -w) || (dx >= w)) { // Everything moves out
+    fillRect(x, y, w, h, c);
+    return;
+  }
+
+  switch (rotation) {
+  case 0:
+    scrollRawRect(x, y, w, h, dx);
+    break;
+  case 2: // Mirrored both ways: the shift is reversed
+    scrollRawRect(WIDTH - x - w, HEIGHT - y - h, w, h, -dx);
+    break;
+  default: // Columns here are matrix rows -- move pixel by pixel
+    if (dx < 0) {
+      for (i = x; i < x + w + dx; i++)
+        for (j = y; j < y + h; j++)
+          drawPixel(i, j, getPixel(i - dx, j));
+    } else {
+      for (i = x + w - 1; i >= x + dx; i--)
+        for (j = y; j < y + h; j++)
+          drawPixel(i, j, getPixel(i - dx, j));
+    }
+    break;
+  }
+
+  // Then blank the columns left behind
+  if (dx < 0)
+    fillRect(x + w + dx, y, -dx, h, c);
+  else
+    fillRect(x, y, dx, h, c);
+}
+
+// The same plane bits as drawPixel() sets, moved between the halves'
+// positions: R,G,B bits 5-7 <-> 2-4 and, when packed, plane 0's scattered
+// bits (see writeColumn()).  Dithered, the alternate image's row follows.
+void RGBmatrixPanel::crossRow(uint8_t r, boolean up) {
+  uint8_t *image[2] = {matrixbuff[backindex], ditherbuff[backindex]};
+  uint8_t *ptr, i, k, v;
+#if PACKED
+  uint8_t b0, b1, b2;
+#endif
+
+  rowflags[r] |= ROW_DIRTY;
+  for (k = 0; (k < 2) && image[k]; k++) {
+    ptr = &image[k][r * WIDTH * nPlaneRows];
+    for (int16_t x = 0; x < WIDTH; x++, ptr++) {
+      for (i = 0; i < nPlaneRows; i++) {
+        v = ptr[i * WIDTH];
+        if (up)
+          ptr[i * WIDTH] = (v & ~B00011100) | ((v >> 3) & B00011100);
+        else
+          ptr[i * WIDTH] = (v & ~B11100000) | ((v << 3) & B11100000);
+      }
+#if PACKED
+      b0 = ptr[0];
+      b1 = ptr[WIDTH];
+      b2 = ptr[WIDTH * 2];
+      if (up) { // B: byte 0 bit 1 -> byte 1 bit 0, R: 1/1 -> 2/0, G: 0/0 -> 2/1
+        ptr[WIDTH] = (b1 & ~B00000001) | ((b0 >> 1) & 1);
+        ptr[WIDTH * 2] =
+            (b2 & ~B00000011) | ((b1 >> 1) & 1) | ((b0 & 1) << 1);
+      } else { // And back
+        ptr[0] = (b0 & ~B00000011) | ((b2 >> 1) & 1) | ((b1 & 1) << 1);
+        ptr[WIDTH] = (b1 & ~B00000010) | ((b2 & 1) << 1);
+      }
+#endif
+    }
+  }
+}
+
+// A line feed rotates the rings one row, which brings every row along
+// except the one leaving one half for the other: that row is moved with
+// crossRow(), and the row it vacates at the far end is filled.
+void RGBmatrixPanel::scrollRows(int16_t dy, uint16_t c) {
+  uint8_t off, i;
+
+  if ((dy <= -HEIGHT) || (dy >= HEIGHT)) { // Everything moves out
+    fillRawRect(0, 0, WIDTH, HEIGHT, c);
+    return;
+  }
+
+  for (; dy < 0; dy++) { // Up: top of the lower half joins the upper half
+    off = rowoffset[backindex];
+    crossRow(off, true);
+    rowoffset[backindex] = (off + 1 < nRows) ? (off + 1) : 0;
+    fillRawRect(0, HEIGHT - 1, WIDTH, 1, c);
+  }
+  for (; dy > 0; dy--) { // Down: bottom of the upper half joins the lower
+    off = rowoffset[backindex];
+    off = (off > 0) ? (off - 1) : (nRows - 1);
+    crossRow(off, false);
+    rowoffset[backindex] = off;
+    fillRawRect(0, 0, WIDTH, 1, c);
+  }
+
+  // Without multiple buffering, the back buffer is also shown
+  for (i = 0; i < 3; i++) {
+    if (matrixbuff[i] == matrixbuff[backindex])
+      rowoffset[i] = rowoffset[backindex];
+  }
+}
+
+void RGBmatrixPanel::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                   uint16_t c) {
+  fillRect(x, y, 1, h, c);
+}
+
+void RGBmatrixPanel::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                   uint16_t c) {
+  fillRect(x, y, w, 1, c);
+}
+
+void RGBmatrixPanel::fillScreen(uint16_t c) {
+  if (!clipIsScreen()) { // Only the clip rectangle
+    fillRect(0, 0, _width, _height, c);
+    return;
+  }
+  // Every row holds the same plane bytes for a solid color (for
+  // black or white, all bits identically set or unset), so each plane
+  // row of the buffer is simply memset -- see fillRawRect().
+  fillRawRect(0, 0, WIDTH, HEIGHT, c);
+}
+
+// Return address of back buffer -- can then load/store data directly.
+// Any of it may be changed that way, so every row is marked dirty, and
+// none is known to be blank any more.
+uint8_t *RGBmatrixPanel::backBuffer() {
+  uint8_t blank = backBlank();
+
+  for (uint8_t r = 0; r < nRows; r++)
+    rowflags[r] = (rowflags[r] | ROW_DIRTY) & ~blank;
+  return matrixbuff[backindex];
+}
+
+boolean RGBmatrixPanel::rowDirty(uint8_t r) {
+  return (r < nRows) && (rowflags[r] & (ROW_DIRTY | ROW_STALE(backindex)));
+}
 
 // For smooth animation -- drawing always takes place in the "back" buffer;
 // this method pushes it to the "front" for display.  Passing "true", the
@@ -801,17 +1713,156 @@ uint8_t *RGBmatrixPanel::backBuffer() { return matrixbuff[backindex]; }
 // be incrementally modified.  If "false", the back buffer then contains
 // the old front buffer contents -- your code can either clear this or
 // draw over every pixel.  (No effect if double-buffering is not enabled.)
+// With triple buffering, "old front buffer contents" may instead be an
+// older or dropped frame -- same rule applies.
 void RGBmatrixPanel::swapBuffers(boolean copy) {
-  if (matrixbuff[0] != matrixbuff[1]) {
+  // Spin rather than delay(1): the swap lands at the end of a refresh
+  // cycle, and waking up to a millisecond late would throttle frame rate.
+  swapBuffersAsync(copy);
+  while (!swapComplete())
+    ;
+}
+
+boolean RGBmatrixPanel::swapBuffersAsync(boolean copy) {
+  uint8_t r, f, stale;
+
+  if (nBuffers == 1)
+    return true;
+  if ((nBuffers == 2) && (swapflag == true))
+    return false;
+  // Settle the prior swap if the caller never polled for it: the back
+  // buffer index (double buffered) and any copy asked for are only
+  // brought up to date there, else the frame now shown would be queued.
+  swapComplete();
+  stale = ROW_DIRTY | ROW_STALE(backindex);
+
+  // The finished frame becomes the newest one: wherever it was drawn to
+  // (or was itself behind), every other buffer is now behind it.
+  for (r = 0; r < nRows; r++) {
+    f = rowflags[r];
+    if (f & stale)
+      f |= ROW_STALE_ALL;
+    rowflags[r] = f & ~stale;
+  }
+  latestindex = backindex;
+  swapcopy = copy;
+
+  if (nBuffers == 2) {
     // To avoid 'tearing' display, actual swap takes place in the interrupt
     // handler, at the end of a complete screen refresh cycle.
-    swapflag = true; // Set flag here, then...
-    while (swapflag == true)
-      delay(1); // wait for interrupt to clear it
-    if (copy == true)
-      memcpy(matrixbuff[backindex], matrixbuff[1 - backindex],
-             WIDTH * nRows * 3);
+    readyindex = backindex;
+    swapflag = true; // Interrupt clears this once swapped
+  } else {
+    // Queue the frame and carry on in whichever buffer is neither shown
+    // nor queued -- the interrupt may switch buffers meanwhile, hence the
+    // critical section.
+    noInterrupts();
+    if (swapflag == true) { // Prior frame never made it to the display
+      r = readyindex;
+      framedrops++;
+    } else {
+      r = 3 - frontindex - backindex;
+    }
+    readyindex = backindex;
+    swapflag = true;
+    backindex = r;
+    interrupts();
+  }
+  return true;
+}
+
+boolean RGBmatrixPanel::swapComplete(void) {
+  if (nBuffers == 2) {
+    if (swapflag == true)
+      return false;
+    backindex = 1 - frontindex;
+  }
+  if (swapcopy == true) {
+    copyDirtyRows();
+    swapcopy = false;
+  }
+  return true;
+}
+
+void RGBmatrixPanel::setSwapPin(int8_t pin) {
+  noInterrupts(); // Port is toggled from the interrupt handler
+  swapport = NULL;
+  if (pin >= 0) {
+    pinMode(pin, OUTPUT);
+    swapport = portOutputRegister(digitalPinToPort(pin));
+    swapmask = digitalPinToBitMask(pin);
   }
+  interrupts();
+}
+
+#if defined(RGBMATRIX_PRESENT_LOG)
+uint8_t RGBmatrixPanel::readPresentLog(RGBmatrixPresent *entries, uint8_t size,
+                                       uint32_t *lost) {
+  uint8_t n, i;
+
+  noInterrupts(); // Log is written from the interrupt handler
+  n = min(size, presentcount);
+  // Oldest entry first: presentcount entries back from the head
+  i = (presenthead + RGBMATRIX_PRESENT_LOG - presentcount) %
+      RGBMATRIX_PRESENT_LOG;
+  for (uint8_t e = 0; e < n; e++) {
+    entries[e] = presentlog[i];
+    if (++i >= RGBMATRIX_PRESENT_LOG)
+      i = 0;
+  }
+  presentcount -= n;
+  if (lost)
+    *lost = presentlost;
+  presentlost = 0;
+  interrupts();
+  return n;
+}
+#endif
+
+uint32_t RGBmatrixPanel::framesShown(void) {
+  uint32_t n;
+
+  noInterrupts(); // Counter is updated from the interrupt handler
+  n = frameshown;
+  interrupts();
+  return n;
+}
+
+#if defined(RGBMATRIX_STATS)
+void RGBmatrixPanel::getStats(RGBmatrixStats *s, boolean reset) {
+  noInterrupts(); // Counts are updated from the interrupt handler
+  memcpy(s, &stats, sizeof stats);
+  if (reset)
+    memset(&stats, 0, sizeof stats);
+  interrupts();
+}
+#endif
+
+// Only rows stale in the back buffer can differ from the newest frame, so
+// only they are copied; rows stay stale across a swap without copy, until
+// the next one with.
+void RGBmatrixPanel::copyDirtyRows(void) {
+  uint16_t rowsize = WIDTH * nPlaneRows;
+  uint8_t stale = ROW_STALE(backindex);
+
+  copybytes = 0;
+  if (!matrixbuff[0]) // Released
+    return;
+  for (uint8_t r = 0; r < nRows; r++) {
+    if (rowflags[r] & stale) {
+      memcpy(&matrixbuff[backindex][r * rowsize],
+             &matrixbuff[latestindex][r * rowsize], rowsize);
+      if (ditherbuff[backindex])
+        memcpy(&ditherbuff[backindex][r * rowsize],
+               &ditherbuff[latestindex][r * rowsize], rowsize);
+      copybytes += rowsize;
+      rowflags[r] &= ~(stale | ROW_BLANK(backindex));
+      if (rowflags[r] & ROW_BLANK(latestindex)) // Black there, so here too
+        rowflags[r] |= ROW_BLANK(backindex);
+    }
+  }
+  rowoffset[backindex] = rowoffset[latestindex]; // Scrolled alike
+  copytotal += copybytes;
 }
 
 // Dump display contents to the Serial Monitor, adding some formatting to
@@ -821,8 +1872,10 @@ void RGBmatrixPanel::swapBuffers(boolean copy) {
 // back into the display using a pgm_read_byte() loop.
 void RGBmatrixPanel::dumpMatrix(void) {
 
-  int i, buffsize = WIDTH * nRows * 3;
+  int i, buffsize = WIDTH * nRows * nPlaneRows;
 
+  if (!matrixbuff[0]) // Released
+    return;
   Serial.print(F("\n\n"
                  "#include <avr/pgmspace.h>\n\n"
                  "static const uint8_t PROGMEM img[] = {\n  "));
@@ -855,13 +1908,17 @@ void RGBmatrixPanel::setFont(const GFXfont * f)
 
 // -------------------- Interrupt handler stuff --------------------
 
-#if defined(__AVR__)
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
 
 ISR(TIMER1_OVF_vect, ISR_BLOCK) { // ISR_BLOCK important -- see notes later
   activePanel->updateDisplay();   // Call refresh func for active display
   TIFR1 |= TOV1;                  // Clear Timer1 interrupt flag
 }
 
+ISR(TIMER1_COMPB_vect, ISR_BLOCK) { // Only enabled when dimmed
+  activePanel->updateOutput();
+}
+
 #elif defined(ARDUINO_ARCH_SAMD)
 
 void IRQ_HANDLER() {
@@ -901,9 +1958,13 @@ IRAM_ATTR void IRQ_HANDLER(void *arg) {
 // issuing loop (not actually a 'loop' because it's unrolled, but eh).
 // Both numbers are rounded up slightly to allow a little wiggle room
 // should different compilers produce slightly different results.
-#if defined(__AVR__)
+// On AVR, begin() then replaces them with the times of the code as
+// actually compiled (see calibrate()), so these are just a starting
+// point there.
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
 #define CALLOVERHEAD 60 // Actual value measured = 56
 #define LOOPTIME 200    // Actual value measured = 188
+#define UNPACKTIME 920  // Same, for the plane 0 unpacking loop (see below)
 #endif
 #if defined(ARDUINO_ARCH_SAMD)
 #define CALLOVERHEAD 60 // Actual = 58
@@ -937,6 +1998,379 @@ IRAM_ATTR void IRQ_HANDLER(void *arg) {
 // 16x32 matrix uses about half that CPU load.  CPU time could be
 // further adjusted by padding the LOOPTIME value, but refresh rates
 // will decrease proportionally, and 200 Hz is a decent target.
+// Unpacked (RGBMATRIX_UNPACKED), bitplane 0 is issued like the others:
+// 320 * 4 = 1280 ticks per row, CPU use = 1280 / 4800 = ~27% at the
+// same refresh rate, for 4 bytes of RAM per column per row instead of 3
+// (2048 instead of 1536 per buffer on a 32x32 matrix).  Both figures are
+// estimates from these tick counts, which leave out the row switch and
+// address settling; build with RGBMATRIX_STATS to measure either on the
+// board ('stats' command).
+
+// The plane intervals depend only on the row count, so they're worked
+// out once rather than shifted into place on every interrupt.  6 planes
+// is the most that fits 16 bits at the slowest (SAMD, <= 8 rows) timing.
+void RGBmatrixPanel::setPlaneTimes(void) {
+  uint16_t t = (nRows > 8) ? looptime : (looptime * 2);
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  // Packed plane 0 is unpacked while the last plane is shown, so that
+  // interval must outlast it too (it does, unless timed very tightly).
+  if (PACKED &&
+      (((t + calloverhead * 2) << 3) < unpacktime + calloverhead * 2))
+    t = ((unpacktime + calloverhead * 2 + 7) >> 3) - calloverhead * 2;
+#endif
+
+  for (uint8_t p = 0; p < nPlanes; p++)
+    planeticks[p] = ((t + calloverhead * 2) << p) - calloverhead;
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  // Timer count when an interval's LEDs go on, near enough
+  uint16_t lead = 0;
+
+  if (rowticks) {
+    // Locked (see lockRefreshRate()): a row's ticks are shared out in
+    // the same proportions, any left over going to the longest plane.
+    // The timer isn't restarted, so an interval is exactly TOP + 1.
+    uint16_t unit = rowticks / ((1 << nPlanes) - 1);
+
+    for (uint8_t p = 0; p < nPlanes; p++)
+      planeticks[p] = (unit << p) - 1;
+    planeticks[nPlanes - 1] += rowticks - unit * ((1 << nPlanes) - 1);
+    lead = calloverhead;
+  }
+
+  frameus = 1000000.0 / refreshRate(); // For syncEdge()
+
+  // Dimmed, a plane is lit for its share of the interval (interrupt to
+  // interrupt) either from the start until compare B, or from compare B
+  // to the end.  The former is only exact if the share outlasts loading
+  // the next plane, which holds off the compare interrupt -- so short
+  // shares, the least planes' at low brightness, take the latter.
+  planelate = 0;
+  for (uint8_t p = 0; p < nPlanes; p++) {
+    uint16_t load = (PACKED && (p == nPlanes - 1)) ? unpacktime
+                                                           : looptime;
+    uint16_t period = planeticks[p] + (rowticks ? 1 : calloverhead);
+    uint16_t on = ((uint32_t)period * brightness + 127) / 255;
+
+    if (on >= load) {
+      planeon[p] = lead + on; // Past TOP (never matched): lit throughout
+    } else {
+      planeon[p] = lead + period - calloverhead - on;
+      planelate |= 1 << p;
+    }
+    if (planeon[p] == 0)
+      planeon[p] = 1; // Match at 0 would be blocked by the TCNT1 write
+  }
+#endif
+}
+
+void RGBmatrixPanel::resetPlaneTimes(void) {
+  calloverhead = CALLOVERHEAD;
+  looptime = LOOPTIME;
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  unpacktime = UNPACKTIME;
+#endif
+  setPlaneTimes();
+}
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+// The interrupt handler times itself while calibrating (see the end of
+// updateDisplay()): calloverhead becomes the least time from a timer
+// overflow to the restart of the timer, looptime the most from there to
+// the end of a plane's data, and unpacktime the same for packed plane 0.
+// Every plane is sampled a few times, on whatever rows come up, while
+// the display runs on the current plane times.
+void RGBmatrixPanel::calibrate(void) {
+  cli();
+  calloverhead = 0xFFFF;
+  looptime = 0;
+  unpacktime = 0;
+  calsamples = nPlanes * 4;
+  sei();
+
+  while (calsamples)
+    ;
+
+  cli();
+  setPlaneTimes();
+  sei();
+}
+#endif
+
+float RGBmatrixPanel::lockRefreshRate(float fps) {
+  lockfps = fps;
+  if (activePanel != this) // Applied by begin()
+    return 0.0;
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  uint16_t least;
+  uint32_t frame, addrticks;
+  float k;
+
+  // Free-running plane times first, which are the shortest that fit
+  cli();
+  rowticks = 0;
+  framepad = 0;
+  setPlaneTimes();
+  sei();
+  if (fps <= 0.0)
+    return 0.0;
+
+  // Untimed, the interrupt that sets the row address (shown plane 0)
+  // also spends its settle time in the interval
+  addrticks = (uint32_t)addrdelay * (F_CPU / 1000000L);
+  if (!addrport)
+    addrticks *= (nRows > 16) ? 5 : ((nRows > 8) ? 4 : 3);
+  least = planeticks[0] + calloverhead + addrticks;
+
+  // Fastest whole multiple of the camera rate, then its frame rounded
+  // to the tick, the rows sharing it and the last one padded
+  k = floor(F_CPU / (fps * nRows * ((uint32_t)least * ((1 << nPlanes) - 1))));
+  if (k < 1.0)
+    return 0.0;
+  frame = (uint32_t)(F_CPU / (k * fps) + 0.5);
+  if (frame / nRows > 0xFFFF)
+    return 0.0;
+
+  cli();
+  rowticks = frame / nRows;
+  framepad = frame % nRows;
+  setPlaneTimes();
+  sei();
+
+  return (float)F_CPU / frame;
+#else
+  return 0.0;
+#endif
+}
+
+float RGBmatrixPanel::refreshRate(void) {
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  uint32_t row = 0;
+
+  // Free-running, the timer restarts a little after each overflow
+  for (uint8_t p = 0; p < nPlanes; p++)
+    row += planeticks[p] + 1 + (rowticks ? 0 : calloverhead);
+
+  return (float)F_CPU / (row * nRows + framepad);
+#else
+  return 0.0;
+#endif
+}
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+static void syncInterrupt(void) { activePanel->syncEdge(); }
+#endif
+
+boolean RGBmatrixPanel::syncTo(int8_t pin, uint16_t window, int mode) {
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  if (syncpin >= 0) {
+    detachInterrupt(digitalPinToInterrupt(syncpin));
+    syncpin = -1;
+  }
+  if ((activePanel != this) || (pin < 0) ||
+      (digitalPinToInterrupt(pin) == NOT_AN_INTERRUPT))
+    return false;
+
+  pinMode(pin, INPUT);
+  noInterrupts();
+  memset(&sync, 0, sizeof sync);
+  syncwindow = window;
+  syncpin = pin;
+  framestart = micros(); // Until the next frame starts
+  interrupts();
+  attachInterrupt(digitalPinToInterrupt(pin), syncInterrupt, mode);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void RGBmatrixPanel::getSync(RGBmatrixSync *s, boolean reset) {
+  noInterrupts(); // Updated from the sync interrupt
+  memcpy(s, &sync, sizeof sync);
+  if (reset) {
+    sync.edges = 0;
+    sync.restarts = 0;
+  }
+  interrupts();
+}
+
+// Runs with the refresh interrupt held off, so the scan state can't
+// change underneath it.
+void RGBmatrixPanel::syncEdge(void) {
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  int32_t error = micros() - framestart;
+
+  // From the nearest frame start: negative if one is about to begin
+  if (error > (int32_t)(frameus / 2))
+    error -= frameus;
+  sync.edges++;
+  sync.error = error;
+
+  if ((error <= (int32_t)syncwindow) && (error >= -(int32_t)syncwindow)) {
+    if (sync.inphase < 0xFFFF)
+      sync.inphase++;
+    sync.locked = (sync.inphase >= 3);
+    return;
+  }
+
+  // Out of phase: end the frame now.  The next refresh interrupt, brought
+  // forward to the next timer tick, wraps around to the top row, which
+  // is then loaded and shown from the interrupt after.
+  sync.restarts++;
+  sync.inphase = 0;
+  sync.locked = false;
+  plane = nPlanes - 1;
+  row = nRows - 1;
+  TCNT1 = ICR1;
+#endif
+}
+
+void RGBmatrixPanel::setBrightness(uint8_t b) {
+  brightness = b;
+  if (activePanel != this) // Applied by begin()
+    return;
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  TIMSK1 &= ~_BV(OCIE1B); // Not needed at full brightness, nor when off
+  setPlaneTimes();
+  if ((b > 0) && (b < 255)) {
+    TIFR1 = _BV(OCF1B); // Clear any stale match
+    TIMSK1 |= _BV(OCIE1B);
+  }
+#endif
+}
+
+// Each dimmed interval has one compare B match, which either ends the lit
+// part (LEDs enabled by updateDisplay()) or starts it -- unless it's a
+// blank row's, left unlit throughout.
+void RGBmatrixPanel::updateOutput(void) {
+  if (!showblank)
+    *oeport ^= oemask;
+}
+
+void RGBmatrixPanel::setBlankRows(RGBmatrixBlankRows mode) {
+  blankrows = mode;
+}
+
+// The generator's row and the plane bytes made from it share a block,
+// allocated on first use and kept, like the dither images.
+boolean RGBmatrixPanel::setPattern(RGBmatrixPattern gen) {
+  int rowsize = WIDTH * nPlaneRows;
+
+  if (!gen && !matrixbuff[0]) // Nothing else left to show
+    return false;
+  if (gen && !patternrow) {
+    if (NULL == (patternrow = (uint8_t *)malloc(rowsize + WIDTH * 2)))
+      return false;
+    patterncolors = (uint16_t *)&patternrow[rowsize];
+  }
+  pattern = gen; // Takes effect at the next frame
+  return true;
+}
+
+// The interrupt stops reading the buffers as it moves on to the pattern,
+// at the next frame wrap.  matrixbuff[0] and ditherbuff[0] are always the
+// start of their blocks (see init() and tripleBuffers()).
+boolean RGBmatrixPanel::releaseBuffers(void) {
+  if (!pattern)
+    return false;
+  while (scanpattern != pattern)
+    ;
+  free(matrixbuff[0]);
+  free(ditherbuff[0]);
+  memset(matrixbuff, 0, sizeof matrixbuff);
+  memset(ditherbuff, 0, sizeof ditherbuff);
+  dither = false;
+  return true;
+}
+
+void RGBmatrixPanel::setAddressDelay(uint8_t us) {
+  addrdelay = us;
+  if (lockfps > 0.0) // Settle time counts against a locked rate's intervals
+    lockRefreshRate(lockfps);
+}
+
+// Select the current row on the address lines.  Called from
+// updateDisplay() only, while LED output is disabled.
+inline void RGBmatrixPanel::setRowAddress(void) {
+  if (addrport) { // All lines on one PORT: a single write
+    PortType bits = 0;
+
+    if (row & 0x1)
+      bits |= addramask;
+    if (row & 0x2)
+      bits |= addrbmask;
+    if (row & 0x4)
+      bits |= addrcmask;
+    if (row & 0x8)
+      bits |= addrdmask;
+    if (row & 0x10)
+      bits |= addremask;
+    *addrport = (*addrport & ~addrmask) | bits;
+    // MYSTERY: certain matrices REQUIRE these delays ???
+    if (addrdelay)
+      delayMicroseconds(addrdelay);
+    return;
+  }
+
+  if (row & 0x1)
+    *addraport |= addramask;
+  else
+    *addraport &= ~addramask;
+  if (addrdelay)
+    delayMicroseconds(addrdelay);
+  if (row & 0x2)
+    *addrbport |= addrbmask;
+  else
+    *addrbport &= ~addrbmask;
+  if (addrdelay)
+    delayMicroseconds(addrdelay);
+  if (row & 0x4)
+    *addrcport |= addrcmask;
+  else
+    *addrcport &= ~addrcmask;
+  if (addrdelay)
+    delayMicroseconds(addrdelay);
+  if (nRows > 8) {
+    if (row & 0x8)
+      *addrdport |= addrdmask;
+    else
+      *addrdport &= ~addrdmask;
+    if (addrdelay)
+      delayMicroseconds(addrdelay);
+  }
+  if (nRows > 16) {
+    if (row & 0x10)
+      *addreport |= addremask;
+    else
+      *addreport &= ~addremask;
+    if (addrdelay)
+      delayMicroseconds(addrdelay);
+  }
+}
+
+// Both halves of the row being loaded are generated into plane bytes laid
+// out as a buffer row, the upper half's bits set and the lower half's
+// merged in.  Runs of one color (most of a test pattern) are split into
+// plane bits once, as in fillRawRect().
+void RGBmatrixPanel::loadPattern(void) {
+  uint8_t bits[nPlaneRows], mask[nPlaneRows], half, i, *ptr;
+  uint16_t c = 0, *colors = patterncolors;
+
+  for (half = 0; half < 2; half++) {
+    scanpattern(row + half * nRows, patternframe, colors);
+    for (int16_t x = 0; x < WIDTH; x++) {
+      if ((x == 0) || (colors[x] != c))
+        planeBits(c = colors[x], half, bits, mask);
+      ptr = &patternrow[x];
+      for (i = 0; i < nPlaneRows; i++, ptr += WIDTH)
+        *ptr = half ? (*ptr | bits[i]) : bits[i];
+    }
+  }
+}
 
 // The flow of the interrupt can be awkward to grasp, because data is
 // being issued to the LED matrix for the *next* bitplane and/or row
@@ -948,8 +2382,11 @@ IRAM_ATTR void RGBmatrixPanel::updateDisplay(void) {
 #else
 void RGBmatrixPanel::updateDisplay(void) {
 #endif
-  uint8_t i, tick, tock, *ptr;
-  uint16_t t, duration;
+  uint8_t i, tick, tock, shown, *ptr;
+  uint16_t duration;
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  uint16_t t0;
+#endif
 
   *oeport |= oemask;   // Disable LED output during row/plane switchover
   *latport |= latmask; // Latch data loaded during *prior* interrupt
@@ -960,8 +2397,12 @@ void RGBmatrixPanel::updateDisplay(void) {
   // result because that time is implicit between the timer overflow
   // (interrupt triggered) and the initial LEDs-off line at the start
   // of this method.
-  t = (nRows > 8) ? LOOPTIME : (LOOPTIME * 2);
-  duration = ((t + CALLOVERHEAD * 2) << plane) - CALLOVERHEAD;
+  duration = planeticks[plane];
+  shown = plane;
+
+  // A blank row (see setBlankRows()) was loaded with nothing, so stays
+  // unlit (its intervals may be cut short below).
+  showblank = loadblank;
 
   // Borrowing a technique here from Ray's Logic:
   // www.rayslogic.com/propeller/Programming/AdafruitRGB/AdafruitRGB.htm
@@ -971,58 +2412,96 @@ void RGBmatrixPanel::updateDisplay(void) {
   // vertical scanning artifacts, in practice with this panel it causes
   // a green 'ghosting' effect on black pixels, a much worse artifact.
 
+  // With a single plane, each row is latched on the interrupt after it
+  // was loaded -- before row is advanced below -- so the address lines
+  // are updated for it here rather than at plane 1.
+  if (nPlanes == 1)
+    setRowAddress();
+
   if (++plane >= nPlanes) {   // Advance plane counter.  Maxed out?
     plane = 0;                // Yes, reset to plane 0, and
     if (++row >= nRows) {     // advance row counter.  Maxed out?
       row = 0;                // Yes, reset row counter, then...
-      if (swapflag == true) { // Swap front/back buffers if requested
-        backindex = 1 - backindex;
+      if (swapflag == true) { // Show queued frame if requested
+        frontindex = readyindex;
         swapflag = false;
+        frameshown++;
+        if (swapport)
+          *swapport ^= swapmask; // Sync output: an edge per frame
+#if defined(RGBMATRIX_PRESENT_LOG)
+        presentlog[presenthead].frame = frameshown;
+        presentlog[presenthead].us = micros();
+        if (++presenthead >= RGBMATRIX_PRESENT_LOG)
+          presenthead = 0;
+        if (presentcount < RGBMATRIX_PRESENT_LOG)
+          presentcount++;
+        else
+          presentlost++; // Oldest overwritten
+#endif
+        if (swapcallback)
+          swapcallback(); // New frame goes live now
       }
-      buffptr = matrixbuff[1 - backindex]; // Reset into front buffer
+#if defined(RGBMATRIX_STATS)
+      stats.frames++;
+#endif
+      // Scan the pattern from the next frame on if one is set (a new one
+      // from its frame 0)
+      if (scanpattern == pattern) {
+        patternframe++;
+      } else {
+        scanpattern = pattern;
+        patternframe = 0;
+      }
+      duration += framepad; // Locked rate: last plane takes up the slack
+      if (syncpin >= 0)
+        framestart = micros(); // Phase reference for syncEdge()
+      // Reset into front buffer, at its first row as scrolled -- if
+      // dithered, into its alternate image every other frame
+      scanbuff = matrixbuff[frontindex];
+      if (dither && (ditherphase = !ditherphase))
+        scanbuff = ditherbuff[frontindex];
+      scanoffset = rowoffset[frontindex];
+      buffptr = &scanbuff[scanoffset * WIDTH * nPlaneRows];
+    } else if (row + scanoffset == nRows) {
+      buffptr = scanbuff; // Wrap around to buffer row 0
     }
-  } else if (plane == 1) {
+    // Is the new row blank, to be passed by (unless calibrate() is timing
+    // the loading)?
+    i = row + scanoffset;
+    if (i >= nRows)
+      i -= nRows;
+    loadblank = (blankrows != BLANK_ROWS_SCAN) && !calsamples &&
+                !scanpattern && (rowflags[i] & ROW_BLANK(frontindex));
+  } else if ((nPlanes > 1) && (plane == 1)) {
     // Plane 0 was loaded on prior interrupt invocation and is about to
     // latch now, so update the row address lines before we do that:
-    if (row & 0x1)
-      *addraport |= addramask;
-    else
-      *addraport &= ~addramask;
-    // MYSTERY: certain matrices REQUIRE these delays ???
-    delayMicroseconds(10);
-    if (row & 0x2)
-      *addrbport |= addrbmask;
-    else
-      *addrbport &= ~addrbmask;
-    delayMicroseconds(10);
-    if (row & 0x4)
-      *addrcport |= addrcmask;
-    else
-      *addrcport &= ~addrcmask;
-    delayMicroseconds(10);
-    if (nRows > 8) {
-      if (row & 0x8)
-        *addrdport |= addrdmask;
-      else
-        *addrdport &= ~addrdmask;
-      delayMicroseconds(10);
-    }
-    if (nRows > 16) {
-      if (row & 0x10)
-        *addreport |= addremask;
-      else
-        *addreport &= ~addremask;
-      delayMicroseconds(10);
-    }
+    setRowAddress();
   }
 
+  // Where a blank row is passed by quickly, its planes take the least
+  // interval -- all but the last one when packed, if the next row is to
+  // be loaded: its plane 0 is unpacked meanwhile (see setPlaneTimes()).
+  // A locked rate keeps every row's intervals.
+  if (showblank && (blankrows == BLANK_ROWS_FAST) && !rowticks &&
+      !(PACKED && (plane == 0) && !loadblank))
+    duration = planeticks[0];
+
   // buffptr, being 'volatile' type, doesn't take well to optimization.
   // A local register copy can speed some things up:
   ptr = (uint8_t *)buffptr;
 
-#if defined(__AVR__)
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  t0 = TCNT1; // Time since the overflow, for calibrate() and statistics
+#if defined(RGBMATRIX_STATS)
+  // The whole interval since the timer last started (ICR1 still holds
+  // the TOP it was timed to, counted 0 to TOP):
+  stats.ticks += ICR1 + 1;
+  if (!rowticks)
+    stats.ticks += t0;
+#endif
   ICR1 = duration; // Set interval for next interrupt
-  TCNT1 = 0;       // Restart interrupt timer
+  if (!rowticks)
+    TCNT1 = 0; // Restart interrupt timer, unless locked to the overflows
 #elif defined(ARDUINO_ARCH_SAMD)
 #ifdef __SAMD51__
   TIMER->COUNT16.CC[0].reg = duration;
@@ -1048,7 +2527,21 @@ TG[TIMER_GROUP_1]->hw_timer[TIMER_0].alarm_high = (uint32_t)(duration >> 32);
 TG[TIMER_GROUP_1]->hw_timer[TIMER_0].alarm_low = (uint32_t)duration;
 portEXIT_CRITICAL(&timer_spinlock[TIMER_GROUP_1]);
 #endif                  // ARDUINO_ARCH_SAMD
-  *oeport &= ~oemask;   // Re-enable output
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  if (brightness < 255) {
+    // Dimmed: compare B switches the LEDs.  OCR1B is double-buffered in
+    // this timer mode, taking effect from the next overflow, so it is
+    // set for the plane being loaded now rather than the one shown.
+    OCR1B = planeon[plane];
+    if (brightness && !showblank && !(planelate & (1 << shown)))
+      *oeport &= ~oemask; // Lit from now until compare B
+  } else if (!showblank) {
+    *oeport &= ~oemask; // Re-enable output
+  }
+#else
+  if (!showblank)
+    *oeport &= ~oemask; // Re-enable output
+#endif
   *latport &= ~latmask; // Latch down
 
   // Record current state of CLKPORT register, as well as a second
@@ -1060,16 +2553,31 @@ portEXIT_CRITICAL(&timer_spinlock[TIMER_GROUP_1]);
   // might otherwise also be twiddling the port at the same time
   // (else this would clobber them). only needed for AVR's where you
   // cannot set one bit in a single instruction
-#if defined(__AVR__)
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
   tock = CLKPORT;
   tick = tock | clkmask;
 #endif
 
-  if (plane > 0) { // 188 ticks from TCNT1=0 (above) to end of function
+  // A pattern's row is generated whole as its plane 0 is issued (see
+  // setPattern()), then issued from there like a buffer row.
+  if (scanpattern && (plane == 0)) {
+    loadPattern();
+    ptr = patternrow;
+    buffptr = ptr;
+  }
+
+  // 188 ticks from TCNT1=0 (above) to end of function, for planes 1-3:
+  if (loadblank) {
+    // Nothing to issue for a blank row, it won't be lit
+    if (!PACKED || (plane > 0))
+      buffptr = ptr + WIDTH; // As if issued
+  } else if (!PACKED || (plane > 0)) {
 
     // Planes 1-3 copy bytes directly from RAM to PORT without unpacking.
     // The least 2 bits (used for plane 0 data) are presumed masked out
-    // by the port direction bits.
+    // by the port direction bits.  Without packing (nPlanes other than
+    // 4, or RGBMATRIX_UNPACKED), plane 0 is stored the same way and is
+    // issued here too.
 
 #if defined(__AVR__)
 // A tiny bit of inline assembly is used; compiler doesn't pick
@@ -1087,6 +2595,11 @@ portEXIT_CRITICAL(&timer_spinlock[TIMER_GROUP_1]);
                [ data ] "I"(_SFR_IO_ADDR(DATAPORT)),                           \
                [ clk ] "I"(_SFR_IO_ADDR(CLKPORT)), [ tick ] "r"(tick),         \
                [ tock ] "r"(tock));
+#elif defined(ARDUINO_ARCH_NATIVE)
+#define pew                                                                    \
+  DATAPORT = *ptr++;                                                           \
+  CLKPORT = tick;                                                              \
+  CLKPORT = tock;
 #elif defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_ESP32)
 #ifdef __SAMD51__ // No IOBUS on SAMD51
 #define pew                                                                    \
@@ -1118,7 +2631,7 @@ portEXIT_CRITICAL(&timer_spinlock[TIMER_GROUP_1]);
     buffptr = ptr; //+= 32;
 
   } else { // 920 ticks from TCNT1=0 (above) to end of function
-#if defined(__AVR__)
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
     // Planes 1-3 (handled above) formatted their data "in place,"
     // their layout matching that out the output PORT register (where
     // 6 bits correspond to output data lines), maximizing throughput
@@ -1146,4 +2659,33 @@ portEXIT_CRITICAL(&timer_spinlock[TIMER_GROUP_1]);
     *outclrreg = clkmask; // Set clock low
 #endif
   }
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_NATIVE)
+  if (calsamples) { // Being timed by calibrate()
+    uint16_t t1 = TCNT1;
+
+    if (t0 < calloverhead)
+      calloverhead = t0;
+    if (PACKED && (plane == 0)) {
+      if (t1 > unpacktime)
+        unpacktime = t1;
+    } else if (t1 > looptime) {
+      looptime = t1;
+    }
+    calsamples--;
+  }
+#endif
+
+#if defined(RGBMATRIX_STATS)
+  // Busy from the overflow to here.  If the timer has overflowed again
+  // meanwhile, the next interrupt is already late: the plane just latched
+  // is shown longer than planned.
+  t0 = rowticks ? TCNT1 : (t0 + TCNT1);
+  stats.interrupts++;
+  stats.busy += t0;
+  stats.planebusy[plane] += t0;
+  stats.rowbusy[row] += t0;
+  if (TIFR1 & _BV(TOV1))
+    stats.missed++;
+#endif
 }
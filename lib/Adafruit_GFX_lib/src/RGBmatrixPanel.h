@@ -27,11 +27,92 @@
 #endif
 #include "Adafruit_GFX.h"
 #include "fonts.h"
-#if defined(__AVR__)
+#if defined(ARDUINO_ARCH_NATIVE)
+typedef uint8_t PortType; // Host build, simulating an AVR (lib/ArduinoNative)
+typedef SimPort PortReg;  ///< PORT register type (records each write)
+#elif defined(__AVR__)
 typedef uint8_t PortType;
 #elif defined(__arm__) || defined(__xtensa__)
 typedef uint32_t PortType; // Formerly 'RwReg' but interfered w/CMCIS header
 #endif
+#if !defined(ARDUINO_ARCH_NATIVE)
+typedef volatile PortType PortReg; ///< PORT register type
+#endif
+
+#ifndef RGBMATRIX_PLANES
+/*!
+  @brief  Bits per R,G,B component (1 to 6), normally set from the build
+          flags, e.g. -D RGBMATRIX_PLANES=2.  Fewer planes take less RAM
+          and refresh faster; 5 or 6 are best left to 32-bit boards.
+*/
+#define RGBMATRIX_PLANES 4
+#endif
+
+// Build with -D RGBMATRIX_STATS to have the refresh interrupt time itself
+// (AVR and host builds); see RGBmatrixPanel::getStats().  Build with
+// -D RGBMATRIX_PRESENT_LOG=n to have it log when the last n (1 to 255)
+// swapped frames went on display; see RGBmatrixPanel::readPresentLog().
+// Build with -D RGBMATRIX_UNPACKED to store 4 planes a byte each per
+// column rather than packed into 3: a third more RAM, about a third less
+// interrupt CPU time.
+
+#if defined(RGBMATRIX_STATS)
+/*!
+  @brief  Refresh interrupt measurements, in Timer1 ticks (CPU cycles).
+          An interrupt is timed from the timer overflow to the end of
+          updateDisplay(); the return from it isn't counted.
+*/
+typedef struct {
+  uint32_t interrupts; ///< Interrupts serviced
+  uint32_t frames;     ///< Complete refresh cycles (all rows and planes)
+  uint32_t missed;     ///< Interrupts that ran past the next one's due time
+  uint32_t ticks;      ///< Time elapsed, overflow to overflow
+  uint32_t busy;       ///< Time spent in the interrupt
+  uint32_t planebusy[RGBMATRIX_PLANES]; ///< Time spent loading each plane
+  uint32_t rowbusy[32]; ///< Time spent loading each multiplexed row
+} RGBmatrixStats;
+#endif
+
+/*!
+  @brief  Phase of the refresh against an external frame sync, see
+          RGBmatrixPanel::syncTo().  Times are in microseconds.
+*/
+typedef struct {
+  uint32_t edges;    ///< Sync edges seen
+  uint32_t restarts; ///< Edges that found the scan out of phase and restarted it
+  int32_t error;     ///< Scan phase at the last edge: frame start to edge
+  uint16_t inphase;  ///< Edges in a row found within the window
+  boolean locked;    ///< Several edges in a row found within the window
+} RGBmatrixSync;
+
+/*!
+  @brief  What the refresh interrupt does with rows known to be all black,
+          see RGBmatrixPanel::setBlankRows().
+*/
+typedef enum {
+  BLANK_ROWS_SCAN, ///< Scan them like any other row (the default)
+  BLANK_ROWS_IDLE, ///< Skip loading them, keeping the timing: less CPU time
+  BLANK_ROWS_FAST  ///< Skip loading them and pass them by: faster refresh
+} RGBmatrixBlankRows;
+
+/*!
+  @brief  Procedural image source for the refresh interrupt, see
+          RGBmatrixPanel::setPattern().  Fills colors[] with the 5/6/5
+          colors of (unrotated) matrix row y, one per column, as shown in
+          the given refresh frame (counted from 0, wrapping at 65535).
+*/
+typedef void (*RGBmatrixPattern)(int16_t y, uint16_t frame, uint16_t *colors);
+
+#if defined(RGBMATRIX_PRESENT_LOG)
+/*!
+  @brief  A frame put on display by a swap, see
+          RGBmatrixPanel::readPresentLog().
+*/
+typedef struct {
+  uint32_t frame; ///< Its framesShown() count
+  uint32_t us;    ///< micros() as the scan wrapped around to it
+} RGBmatrixPresent;
+#endif
 
 /*!
     @brief  Class encapsulating RGB LED matrix functionality.
@@ -114,6 +195,42 @@ public:
   */
   void begin(void);
 
+  /*!
+    @brief  Switch to triple buffering (requires 3X RAM).  The renderer
+            then always has a free back buffer: swapBuffers() queues the
+            finished frame and returns without waiting, and the refresh
+            interrupt shows the newest queued frame at the next row counter
+            wrap.  A queued frame replaced before it was shown is dropped
+            (see framesDropped()).  Must be called before begin().
+    @return true on success, false if called after begin() or if memory
+            could not be allocated (the prior buffering mode then remains
+            in effect).
+  */
+  boolean enableTripleBuffering(void);
+
+  /*!
+    @brief  Switch temporal dithering on or off.  Colors are stored with
+            RGBMATRIX_PLANES bits per component, the rest of the 5/6/5
+            bits being dropped; dithered, the refresh interrupt alternates
+            frame by frame between the two nearest levels wherever the
+            first bit dropped is set, for one bit more depth per
+            component (e.g. smooth gradients in 4-plane 5/5/5) without
+            more bitplanes or any cost in refresh rate.  The least bit
+            then flickers at half the refresh rate.  Every buffer gets an
+            alternate image (requires 2X RAM, from the first call on);
+            writes made through backBuffer() bypass it.  Not available
+            with 6 planes.
+    @param  on  true to dither, false to show the stored levels alone.
+    @return true on success, false if memory could not be allocated.
+  */
+  boolean setDither(boolean on);
+
+  /*!
+    @brief   Query whether dithering is on (see setDither()).
+    @return  true if dithering.
+  */
+  boolean getDither(void) { return dither; }
+
   /*!
     @brief  Lowest-level pixel drawing function required by Adafruit_GFX.
             Does not have an immediate effect -- must call updateDisplay()
@@ -138,7 +255,18 @@ public:
   void drawPixel(int16_t x, int16_t y, uint16_t c);
 
   /*!
-    @brief  Fill entire matrix a single color.
+    @brief  Draw a pixel that a primitive has already found inside the
+            clip rectangle (see Adafruit_GFX::setClipRect()): drawPixel()
+            without the bounds check.
+    @param  x  Column.
+    @param  y  Row.
+    @param  c  16-bit 5/6/5 color.
+  */
+  void writePixelUnchecked(int16_t x, int16_t y, uint16_t c);
+
+  /*!
+    @brief  Fill entire matrix a single color, or only the clip rectangle
+            if one is set.
             Does not have an immediate effect -- must call updateDisplay()
             after any drawing operations to refresh matrix contents.
     @param  c  Color (16-bit 5/6/5 color, but actual color on matrix
@@ -146,6 +274,125 @@ public:
   */
   void fillScreen(uint16_t c);
 
+  /*!
+    @brief  Draw a vertical line.  Clipped once, then written straight into
+            the bitplane bytes of the back buffer rather than pixel-by-pixel.
+    @param  x  Column.
+    @param  y  Top-most row.
+    @param  h  Height in pixels (negative values extend upward).
+    @param  c  16-bit 5/6/5 color.
+  */
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c);
+
+  /*!
+    @brief  Draw a horizontal line.  Clipped once, then written straight into
+            the bitplane bytes of the back buffer rather than pixel-by-pixel.
+    @param  x  Left-most column.
+    @param  y  Row.
+    @param  w  Width in pixels (negative values extend leftward).
+    @param  c  16-bit 5/6/5 color.
+  */
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c);
+
+  /*!
+    @brief  Fill a rectangle.  Clipped once (to the clip rectangle), then
+            each row segment is written straight into the bitplane bytes
+            of the back buffer.
+    @param  x  Left-most column.
+    @param  y  Top-most row.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+    @param  c  16-bit 5/6/5 color.
+  */
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c);
+
+  /*!
+    @brief  Scroll a rectangle horizontally, e.g. for marquee text: shift
+            its contents by dx pixels and fill the columns left vacated,
+            so only the newly exposed columns need drawing.  The plane
+            bytes of each row are moved in place (memmove where the
+            rectangle spans both halves of the display), so the cost
+            doesn't depend on what was drawn.  At rotation 1 or 3 the
+            shift runs across the matrix rows and goes pixel by pixel.
+    @param  x   Left-most column.
+    @param  y   Top-most row.
+    @param  w   Width in pixels.
+    @param  h   Height in pixels.
+    @param  dx  Shift in pixels, negative to the left.
+    @param  c   16-bit 5/6/5 color for the vacated columns.
+  */
+  void scrollRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx,
+                  uint16_t c);
+
+  /*!
+    @brief  Scroll the whole matrix vertically, e.g. for ticker-style line
+            feeds, and fill the rows scrolled in.  Nothing is copied: the
+            refresh interrupt starts its scan at a different buffer row
+            (ring addressing), and only the one row per line crossing
+            between the upper and lower halves of the display is moved.
+            Only the incoming rows then need drawing.  Acts on the
+            unrotated matrix and the back buffer; takes effect from the
+            next refresh cycle, or with the next swap if double-buffered.
+    @param  dy  Shift in rows, negative for up.
+    @param  c   16-bit 5/6/5 color for the rows scrolled in.
+  */
+  void scrollRows(int16_t dy, uint16_t c);
+
+  /*!
+    @brief   Read a pixel back from the back buffer (the one drawn to).
+    @param   x  Column.
+    @param   y  Row.
+    @return  16-bit 5/6/5 color, as Color444() would give for the stored
+             4-bit components (other bit depths are widened the same way;
+             dithered, the components have the extra bit).  0 if (x,y) is
+             off the matrix.
+  */
+  uint16_t getPixel(int16_t x, int16_t y);
+
+  /*!
+    @brief  Read a whole row back from the back buffer, for screenshots,
+            checksums or streaming without a separate canvas.  Ignores
+            rotation: rows are as scanned by the matrix.
+    @param  y       Matrix row, 0 to height-1 (unrotated).
+    @param  colors  Array of (unrotated) width elements, receives 16-bit
+                    5/6/5 colors, left to right, as from getPixel().
+  */
+  void readRow(int16_t y, uint16_t *colors);
+
+  /*!
+    @brief  Write a whole row of the back buffer at once, e.g. from a
+            canvas, converting runs of one color to bitplanes together.
+            Ignores rotation, as readRow(), and the clip rectangle.
+    @param  y       Matrix row, 0 to height-1 (unrotated).
+    @param  colors  Array of (unrotated) width 16-bit 5/6/5 colors, left
+                    to right.
+  */
+  void writeRow(int16_t y, const uint16_t *colors);
+
+  /*!
+    @brief  Copy a 16-bit canvas to the matrix at x,y, much faster than
+            drawRGBBitmap(): clipped once, then converted to bitplanes a
+            matrix row at a time, two pixels per 32-bit word.  The
+            canvas's buffer is read as stored (its own rotation is
+            ignored); the matrix's rotation applies as for drawing.
+    @param  x       Column of the canvas's left edge.
+    @param  y       Row of its top edge.
+    @param  canvas  Canvas to copy.
+  */
+  void drawCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas);
+
+  /*!
+    @brief  Copy a 1-bit canvas to the matrix at x,y in two colors, as
+            drawCanvas() for a 16-bit one.
+    @param  x       Column of the canvas's left edge.
+    @param  y       Row of its top edge.
+    @param  canvas  Canvas to copy.
+    @param  color   Color of set pixels.
+    @param  bg      Color of clear pixels.
+  */
+  void drawCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color,
+                  uint16_t bg);
+
   /*!
     @brief  Refresh matrix contents following one or more drawing calls.
   */
@@ -156,6 +403,216 @@ public:
   */
   void swapBuffers(boolean);
 
+  /*!
+    @brief  Non-blocking counterpart to swapBuffers(): request a swap at
+            the end of the current refresh cycle and return immediately.
+            The back buffer must not be drawn to until swapComplete()
+            returns true; a swap that completed unpolled is settled here
+            before the next one is requested.
+    @param  copy  If true, the new back buffer receives a copy of the new
+                  front buffer's contents (as swapBuffers(true)).
+    @return false if a swap was already pending (request ignored).  With
+            triple buffering a pending frame is instead dropped in favor of
+            the new one, and this always succeeds.
+  */
+  boolean swapBuffersAsync(boolean copy);
+
+  /*!
+    @brief  Poll for completion of a swap requested with swapBuffersAsync().
+            Once the refresh interrupt has made the swap, this performs any
+            requested copy (dirty rows only) and returns true; the back
+            buffer is then safe to draw to.  With triple buffering there's
+            a free back buffer right away, so this never has to wait.
+    @return true if the back buffer may be drawn to.
+  */
+  boolean swapComplete(void);
+
+  /*!
+    @brief  Register a function to be called when a swap takes effect,
+            i.e. as the new frame goes live at the row counter wrap.  It is
+            called from the refresh interrupt, so must be very brief (set a
+            flag, note a timestamp).  Set before requesting swaps.
+    @param  callback  Function to call, or NULL for none.
+  */
+  void setSwapCallback(void (*callback)(void)) { swapcallback = callback; }
+
+  /*!
+    @brief  Toggle an output pin each time a swap takes effect, i.e. as
+            the new frame goes live at the row counter wrap, so a logic
+            analyzer or the camera's sync input can see when each frame
+            appeared.  The top row is lit one bitplane interval later.
+    @param  pin  Output pin, or -1 for none (the default).
+  */
+  void setSwapPin(int8_t pin);
+
+#if defined(RGBMATRIX_PRESENT_LOG)
+  /*!
+    @brief   Take the oldest entries from the log of swapped frames going
+             on display (see RGBMATRIX_PRESENT_LOG above).
+    @param   entries  Receives up to size entries, oldest first.
+    @param   size     Most entries to take.
+    @param   lost     If not NULL, receives how many entries were
+                      overwritten before being read since the last call.
+    @return  Number of entries taken.
+  */
+  uint8_t readPresentLog(RGBmatrixPresent *entries, uint8_t size,
+                         uint32_t *lost);
+#endif
+
+  /*!
+    @brief  Set how long the refresh interrupt waits for the row address
+            lines to settle after changing them, once per row.  Some
+            panels need a wait (formerly a fixed 10 us per line), but it
+            is spent with LEDs off and interrupts blocked, lowering the
+            refresh rate and holding up serial input.  When the address
+            lines all share a PORT they're set in one write and waited
+            for once, else the wait follows each line.
+    @param  us  Microseconds, 0 for none (default 10).
+  */
+  void setAddressDelay(uint8_t us);
+
+  /*!
+    @brief   Get the address settle time set with setAddressDelay().
+    @return  Microseconds.
+  */
+  uint8_t addressDelay(void) { return addrdelay; }
+
+  /*!
+    @brief  Set the overall brightness, e.g. to suit a camera's exposure.
+            Rather than the colors being redrawn darker, the LEDs are lit
+            for a share of each bitplane interval: the frame buffer is
+            untouched, so no color depth is lost and the change is
+            immediate.  Below full brightness the Timer1 compare B
+            interrupt switches the LEDs mid-interval.  AVR only.
+    @param  b  0 (off) to 255 (full, the default).
+  */
+  void setBrightness(uint8_t b);
+
+  /*!
+    @brief   Get the brightness set with setBrightness().
+    @return  0 (off) to 255 (full).
+  */
+  uint8_t getBrightness(void) { return brightness; }
+
+  /*!
+    @brief  Choose how the refresh interrupt treats rows that are all
+            black, as on screens of a line or two of text.  The drawing
+            functions keep track of them: a row becomes blank when filled
+            black right across (fillScreen(), fillRect()) and stops being
+            blank when anything else is drawn there.  With
+            BLANK_ROWS_IDLE, a blank row's data isn't clocked out and its
+            LEDs stay off, the time saved going to the sketch.  With
+            BLANK_ROWS_FAST, a blank row's bitplane intervals are also
+            cut to the shortest one's -- except, with 4 packed planes, the
+            last one before a lit row, while that row's first plane is
+            unpacked -- raising the refresh rate: the rate (and how
+            bright the lit rows look) then varies with the
+            picture, so it is not for syncTo(), and lockRefreshRate()
+            keeps the timing as with BLANK_ROWS_IDLE.
+    @param  mode  BLANK_ROWS_SCAN (the default), BLANK_ROWS_IDLE or
+                  BLANK_ROWS_FAST.
+  */
+  void setBlankRows(RGBmatrixBlankRows mode);
+
+  /*!
+    @brief   Get the mode set with setBlankRows().
+    @return  BLANK_ROWS_SCAN, BLANK_ROWS_IDLE or BLANK_ROWS_FAST.
+  */
+  RGBmatrixBlankRows blankRows(void) { return blankrows; }
+
+  /*!
+    @brief  Show an image generated row by row in the refresh interrupt
+            instead of the buffers: patterns that are functions of
+            position and frame number (grids, stripes, gradients, sweeps)
+            then cost no drawing at all, animate at the refresh rate and
+            switch instantly.  Drawing goes on in the buffers meanwhile,
+            and shows again once the pattern is removed.  The generator
+            runs as each row's first bitplane is issued, while the row
+            before shows its last (longest) one, and should finish within
+            that interval, else that bitplane is shown longer.  Every row
+            is scanned (setBlankRows() has no effect) and dithering
+            doesn't apply.  Takes effect at the next refresh frame.
+            Requires 2 bytes per column for the row, plus a plane byte
+            per column and bitplane, from the first call on.
+    @param  gen  Generator, or NULL to show the buffers again.
+    @return true on success, false if memory could not be allocated or,
+            for NULL, the buffers have been released.
+  */
+  boolean setPattern(RGBmatrixPattern gen);
+
+  /*!
+    @brief   Get the generator set with setPattern().
+    @return  Generator, or NULL if showing the buffers.
+  */
+  RGBmatrixPattern getPattern(void) { return pattern; }
+
+  /*!
+    @brief  Free the display buffers for other use, once the refresh
+            interrupt has moved on to a pattern.  The panel then shows
+            patterns only: drawing has no effect, readback gives black
+            and backBuffer() returns NULL.  This cannot be undone.
+    @return true once released, false if no pattern is set.
+  */
+  boolean releaseBuffers(void);
+
+  /*!
+    @brief  Switch the LEDs at the dimmed point of a bitplane interval.
+            Called from the Timer1 compare B interrupt, not by sketches.
+  */
+  void updateOutput(void);
+
+  /*!
+    @brief  Lock the refresh rate to a whole multiple of a camera's frame
+            rate, so that every exposure takes in whole refresh cycles
+            instead of beating against them (banding in recordings).  The
+            fastest multiple the display keeps up with is used, padding
+            the bitplane intervals to suit, and the intervals are then
+            timed from one timer overflow to the next, so the rate is as
+            exact as the CPU clock.  AVR only.
+    @param  fps  Camera frame rate, or 0 to go back to refreshing as fast
+                 as possible (the default).
+    @return Refresh rate achieved in Hz, or 0 if not locked (fps 0, or
+            above the fastest refresh rate).
+  */
+  float lockRefreshRate(float fps);
+
+  /*!
+    @brief   Get the refresh rate given by the current bitplane intervals.
+    @return  Frames per second; an estimate unless locked with
+             lockRefreshRate().
+  */
+  float refreshRate(void);
+
+  /*!
+    @brief  Phase-lock the refresh to a camera's frame sync (VSYNC) output.
+            At each sync edge the scan's phase is measured; if a refresh
+            frame didn't start within the window around the edge, the scan
+            is restarted there, from the top.  Combined with
+            lockRefreshRate() for the camera's rate, the scan then stays in
+            phase and restarts are rare (crystal drift only).  A restart
+            shows the row then being scanned once at the wrong weight.
+            AVR only.
+    @param  pin     Pin wired to the sync output, which must have an
+                    external interrupt; -1 to stop syncing.
+    @param  window  Phase error tolerated, in microseconds.
+    @param  mode    Edge to sync to: RISING (default) or FALLING.
+    @return true if syncing, false if stopped or the pin has no interrupt.
+  */
+  boolean syncTo(int8_t pin, uint16_t window = 100, int mode = RISING);
+
+  /*!
+    @brief   Get the phase measurements made at sync edges.
+    @param   sync   Receives the measurements since the last reset.
+    @param   reset  If true, restart the edge and restart counts.
+  */
+  void getSync(RGBmatrixSync *sync, boolean reset);
+
+  /*!
+    @brief  Measure (and if need be restart) the scan at a sync edge.
+            Called from the sync pin interrupt, not by sketches.
+  */
+  void syncEdge(void);
+
   /*!
     @brief  Dump display contents to the Serial Monitor, adding some
             formatting to simplify copy-and-paste of data as a PROGMEM-
@@ -176,6 +633,57 @@ public:
   */
   uint8_t *backBuffer(void);
 
+  /*!
+    @brief   Query whether a multiplexed row of the back buffer may differ
+             from the front buffer, i.e. was drawn to since the last
+             swapBuffers(true).  Lets copies, readback or streaming skip
+             unchanged rows.
+    @param   row  Multiplexed row (0 to rows-1); holds display rows 'row'
+                  and 'row' + rows (unless scrolled with scrollRows()).
+    @return  true if the row is dirty.
+  */
+  boolean rowDirty(uint8_t row);
+
+  /*!
+    @brief   Get the number of bytes copied by the most recent
+             swapBuffers(true).
+    @return  Byte count (at most the size of one buffer).
+  */
+  uint16_t swapCopyBytes(void) { return copybytes; }
+
+  /*!
+    @brief   Get the running total of bytes copied by swapBuffers(true)
+             since the panel was created.
+    @return  Byte count.
+  */
+  uint32_t swapCopyTotal(void) { return copytotal; }
+
+  /*!
+    @brief   Get the number of frames the refresh interrupt has put on
+             display through a swap.
+    @return  Frame count.
+  */
+  uint32_t framesShown(void);
+
+  /*!
+    @brief   Get the number of triple-buffered frames that were replaced by
+             a newer one before the refresh interrupt could show them.
+    @return  Frame count.
+  */
+  uint32_t framesDropped(void) { return framedrops; }
+
+#if defined(RGBMATRIX_STATS)
+  /*!
+    @brief   Get the refresh interrupt's measurements: refresh rate is
+             frames * F_CPU / ticks, CPU load busy / ticks.  The 32-bit
+             tick counts wrap after about 4 minutes at 16 MHz, so read
+             (and reset) them at shorter intervals.
+    @param   stats  Receives the counts accumulated since the last reset.
+    @param   reset  If true, restart all counts from zero.
+  */
+  void getStats(RGBmatrixStats *stats, boolean reset);
+#endif
+
   /*!
     @brief   Promote 3-bits R,G,B (used by earlier versions of this library)
              to the '565' color format used in Adafruit_GFX. New code should
@@ -250,10 +758,81 @@ public:
   
 
 private:
-  uint8_t *matrixbuff[2];     ///< Buffer pointers for double-buffering
-  uint8_t nRows;              ///< Number of rows (derived from A/B/C/D pins)
-  volatile uint8_t backindex; ///< Index (0-1) of back buffer
-  volatile boolean swapflag;  ///< if true, swap on next vsync
+  uint8_t *matrixbuff[3];       ///< Pointers for double/triple-buffering
+  uint8_t nRows;                ///< Number of rows (derived from A/B/C/D pins)
+  uint8_t nBuffers;             ///< Number of distinct buffers (1-3)
+  volatile uint8_t backindex;   ///< Index (0-2) of back buffer
+  volatile uint8_t frontindex;  ///< Index (0-2) of front buffer
+  volatile uint8_t readyindex;  ///< Index (0-2) of frame queued for display
+  uint8_t latestindex;          ///< Index (0-2) of newest complete frame
+  volatile boolean swapflag;    ///< if true, swap on next vsync
+  uint8_t rowflags[32];         ///< Per-multiplexed-row state (ROW_* bits)
+  uint8_t *ditherbuff[3];       ///< Alternate images, or NULL (setDither())
+  boolean dither;               ///< Alternate images shown, every other frame
+  boolean ditherphase;          ///< Alternate image being shown
+  uint8_t rowoffset[3];         ///< Buffer row scanned first, per buffer
+  uint8_t scanoffset;           ///< rowoffset[] of frame being scanned
+  uint16_t copybytes;           ///< Bytes copied by last swapBuffers(true)
+  uint32_t copytotal;           ///< Bytes copied by swapBuffers(true) in total
+  volatile uint32_t frameshown; ///< Frames put on display by interrupt
+  uint32_t framedrops;          ///< Queued frames replaced before shown
+  boolean swapcopy;             ///< Copy pending for swapComplete()
+  void (*swapcallback)(void);   ///< Called from interrupt when swap is made
+  PortReg *swapport;            ///< PORT toggled when swap is made, or NULL
+  PortType swapmask;            ///< Its pin bitmask
+#if defined(RGBMATRIX_PRESENT_LOG)
+  RGBmatrixPresent presentlog[RGBMATRIX_PRESENT_LOG]; ///< Ring of swaps made
+  uint8_t presenthead;  ///< presentlog[] index written next
+  uint8_t presentcount; ///< Entries not yet read
+  uint32_t presentlost; ///< Entries overwritten unread
+#endif
+
+  // Buffer row holding (unrotated) matrix row y, as scrolled.
+  uint8_t bufferRow(int16_t y);
+
+  // ROW_BLANK bits of the back buffer.
+  uint8_t backBlank(void);
+
+  // Generate the row being loaded with the pattern, as plane bytes.
+  void loadPattern(void);
+
+  // Move buffer row r's pixels from the lower half of the display to the
+  // upper half, or back.
+  void crossRow(uint8_t r, boolean up);
+
+  // Drive the address lines for the current row.
+  void setRowAddress(void);
+
+  // Fill planeticks[] for the current row count.
+  void setPlaneTimes(void);
+
+  // Back to the built-in timing constants, then setPlaneTimes().
+  void resetPlaneTimes(void);
+
+  // Time the running refresh interrupt, then setPlaneTimes() from that.
+  void calibrate(void);
+
+  // Bring dirty rows of the back buffer up to date with the newest frame.
+  void copyDirtyRows(void);
+
+  // Span writer shared by fillScreen(), fillRect() and the fast line
+  // functions.  x, y, w and h are unrotated, already clipped matrix
+  // coordinates.
+  void fillRawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c);
+
+  // Write w colors to matrix row y (unrotated) from column x on, already
+  // clipped.
+  void writeSpan(int16_t x, int16_t y, int16_t w, const uint16_t *colors);
+
+  // Clip and write a w x h image at x,y (rotated): 16-bit pixels, or if
+  // NULL, a 1-bit bitmap in color and bg.
+  void blit(int16_t x, int16_t y, int16_t w, int16_t h,
+            const uint16_t *pixels, const uint8_t *bitmap, uint16_t color,
+            uint16_t bg);
+
+  // Shift a rectangle dx columns within each row; coordinates as for
+  // fillRawRect(), and |dx| < w.  Vacated columns are left as they were.
+  void scrollRawRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx);
 
   // Init/alloc code common to both constructors:
   void init(uint8_t rows, uint8_t a, uint8_t b, uint8_t c, uint8_t clk,
@@ -280,14 +859,17 @@ private:
   PortType addrcmask; ///< Address/row-select C pin bitmask
   PortType addrdmask; ///< Address/row-select D pin bitmask
   PortType addremask; ///< Address/row-select E pin bitmask
+  PortType addrmask;  ///< All address/row-select pin bits, if one PORT
+  uint8_t addrdelay;  ///< Address settle time, microseconds
   // PORT register pointers (CLKPORT is hardcoded on AVR)
-  volatile PortType *latport;   ///< RGB latch PORT register
-  volatile PortType *oeport;    ///< Output enable PORT register
-  volatile PortType *addraport; ///< Address/row-select A PORT register
-  volatile PortType *addrbport; ///< Address/row-select B PORT register
-  volatile PortType *addrcport; ///< Address/row-select C PORT register
-  volatile PortType *addrdport; ///< Address/row-select D PORT register
-  volatile PortType *addreport; ///< Address/row-select E PORT register
+  PortReg *latport;   ///< RGB latch PORT register
+  PortReg *oeport;    ///< Output enable PORT register
+  PortReg *addraport; ///< Address/row-select A PORT register
+  PortReg *addrbport; ///< Address/row-select B PORT register
+  PortReg *addrcport; ///< Address/row-select C PORT register
+  PortReg *addrdport; ///< Address/row-select D PORT register
+  PortReg *addreport; ///< Address/row-select E PORT register
+  PortReg *addrport;  ///< PORT register of all address pins, or NULL
 
 #if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_ESP32)
   uint8_t rgbpins[6];           ///< Pin numbers for 2x R,G,B bits
@@ -300,6 +882,34 @@ private:
   volatile uint8_t row;      ///< Row counter for interrupt handler
   volatile uint8_t plane;    ///< Bitplane counter for interrupt handler
   volatile uint8_t *buffptr; ///< Current RGB pointer for interrupt handler
+  uint8_t *scanbuff;         ///< Image being scanned by interrupt handler
+  uint16_t planeticks[RGBMATRIX_PLANES]; ///< Timer interval for each plane
+  uint16_t planeon[RGBMATRIX_PLANES]; ///< Compare B time for each plane
+  uint8_t planelate;  ///< Planes lit from compare B on, 1 bit each
+  uint8_t brightness; ///< 0 (off) to 255 (full)
+  RGBmatrixBlankRows blankrows; ///< What the interrupt does with blank rows
+  boolean loadblank;            ///< Row being loaded is blank and passed by
+  volatile boolean showblank;   ///< Row being shown is blank and passed by
+  RGBmatrixPattern pattern;     ///< Procedural image source, or NULL
+  volatile RGBmatrixPattern scanpattern; ///< Source being scanned, or NULL
+  uint16_t patternframe;   ///< Frame number given to the generator
+  uint8_t *patternrow;     ///< Plane bytes of the row, or NULL
+  uint16_t *patterncolors; ///< Row of colors from the generator
+  uint16_t calloverhead; ///< Ticks from timer overflow to restart
+  uint16_t looptime;     ///< Ticks from timer restart to a plane issued
+  uint16_t unpacktime;   ///< Same, for the packed plane 0 (if packed)
+  volatile uint8_t calsamples; ///< Interrupts left for calibrate() to time
+  float lockfps;     ///< Camera frame rate locked to, 0 if none
+  uint16_t rowticks; ///< Locked timer ticks per row, 0 if free-running
+  uint8_t framepad;  ///< Locked ticks per frame left over from the rows
+  int8_t syncpin;           ///< Frame sync input, -1 if none
+  uint16_t syncwindow;      ///< Phase error tolerated at sync edges, us
+  uint32_t frameus;         ///< Refresh frame period, us
+  volatile uint32_t framestart; ///< micros() as the last refresh frame began
+  RGBmatrixSync sync;       ///< Phase measurements, see getSync()
+#if defined(RGBMATRIX_STATS)
+  RGBmatrixStats stats; ///< Interrupt measurements, see getStats()
+#endif
 };
 
 #endif // RGBMATRIXPANEL_H
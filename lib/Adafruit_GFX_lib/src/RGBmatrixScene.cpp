@@ -0,0 +1,378 @@
+/*!
+ * @file RGBmatrixScene.cpp
+ *
+ * Retained display list for RGBmatrixPanel, see RGBmatrixScene.h.
+ *
+ * update() never compares pixels, only items: each item remembers the area
+ * it covers on screen (drawn), and the setters flag it as changed only if
+ * a setting really differs.  The items redrawn are the changed ones plus,
+ * repeatedly, any item overlapping the old or new area of one already
+ * being redrawn.  Every pixel that can come out differently is then
+ * redrawn by all the items covering it, in list order, so overlapping
+ * items stack as before; any other pixel is drawn again as it was.
+ *
+ */
+
+#include "RGBmatrixScene.h"
+
+#define ITEM_FREE 0   ///< Slot unused
+#define ITEM_TEXT 1   ///< Line of text
+#define ITEM_RECT 2   ///< Rectangle, filled if size is set
+#define ITEM_LINE 3   ///< Line from x,y to x+w,y+h
+#define ITEM_BITMAP 4 ///< 5/6/5 bitmap in PROGMEM
+
+#define ITEM_VISIBLE 0x01 ///< Shown
+#define ITEM_CHANGED 0x02 ///< Settings changed since the last update()
+#define ITEM_REMOVED 0x04 ///< Slot freed by the next update()
+#define ITEM_REDRAW 0x08  ///< Being redrawn, within update()
+
+RGBmatrixScene::RGBmatrixScene(RGBmatrixPanel *matrix, uint8_t size,
+                               uint16_t background)
+    : matrix(matrix), nItems(size), background(background), cleared(true) {
+  if (NULL == (items = (Item *)calloc(size, sizeof(Item))))
+    nItems = 0;
+}
+
+RGBmatrixScene::~RGBmatrixScene(void) { free(items); }
+
+RGBmatrixScene::Item *RGBmatrixScene::newItem(uint8_t type, int16_t x,
+                                              int16_t y, uint16_t color) {
+  for (uint8_t i = 0; i < nItems; i++) {
+    Item *it = &items[i];
+
+    if (it->type == ITEM_FREE) {
+      memset(it, 0, sizeof(Item));
+      it->type = type;
+      it->flags = ITEM_VISIBLE | ITEM_CHANGED;
+      it->x = x;
+      it->y = y;
+      it->color = color;
+      return it;
+    }
+  }
+  return NULL;
+}
+
+RGBmatrixScene::Item *RGBmatrixScene::item(int8_t id) {
+  if ((id < 0) || (id >= nItems) || (items[id].type == ITEM_FREE) ||
+      (items[id].flags & ITEM_REMOVED))
+    return NULL;
+  return &items[id];
+}
+
+int8_t RGBmatrixScene::addText(int16_t x, int16_t y, const char *str,
+                               uint16_t color, uint8_t size,
+                               const GFXfont *font) {
+  Item *it = newItem(ITEM_TEXT, x, y, color);
+
+  if (!it)
+    return -1;
+  strncpy(it->text, str, RGBMATRIX_SCENE_TEXT - 1);
+  it->size = size;
+  it->data = font;
+  return it - items;
+}
+
+int8_t RGBmatrixScene::addRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color, boolean fill) {
+  Item *it;
+
+  // Kept with a positive size, as fillRect() draws it, so that bounds()
+  // covers every pixel drawn; an empty rectangle would draw a line there
+  if (!w || !h)
+    return -1;
+  if (w < 0) {
+    w = -w;
+    x -= w - 1;
+  }
+  if (h < 0) {
+    h = -h;
+    y -= h - 1;
+  }
+  it = newItem(ITEM_RECT, x, y, color);
+  if (!it)
+    return -1;
+  it->w = w;
+  it->h = h;
+  it->size = fill;
+  return it - items;
+}
+
+int8_t RGBmatrixScene::addLine(int16_t x0, int16_t y0, int16_t x1,
+                               int16_t y1, uint16_t color) {
+  Item *it = newItem(ITEM_LINE, x0, y0, color);
+
+  if (!it)
+    return -1;
+  it->w = x1 - x0;
+  it->h = y1 - y0;
+  return it - items;
+}
+
+int8_t RGBmatrixScene::addBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                                 int16_t w, int16_t h) {
+  Item *it = newItem(ITEM_BITMAP, x, y, 0);
+
+  if (!it)
+    return -1;
+  it->w = w;
+  it->h = h;
+  it->data = bitmap;
+  return it - items;
+}
+
+void RGBmatrixScene::setText(int8_t id, const char *str) {
+  Item *it = item(id);
+
+  if (it && (it->type == ITEM_TEXT) &&
+      strncmp(it->text, str, RGBMATRIX_SCENE_TEXT - 1)) {
+    strncpy(it->text, str, RGBMATRIX_SCENE_TEXT - 1);
+    it->flags |= ITEM_CHANGED;
+  }
+}
+
+void RGBmatrixScene::setColor(int8_t id, uint16_t color) {
+  Item *it = item(id);
+
+  if (it && (it->color != color)) {
+    it->color = color;
+    it->flags |= ITEM_CHANGED;
+  }
+}
+
+void RGBmatrixScene::moveTo(int8_t id, int16_t x, int16_t y) {
+  Item *it = item(id);
+
+  if (it && ((it->x != x) || (it->y != y))) {
+    it->x = x;
+    it->y = y;
+    it->flags |= ITEM_CHANGED;
+  }
+}
+
+void RGBmatrixScene::setVisible(int8_t id, boolean visible) {
+  Item *it = item(id);
+
+  if (it && (!(it->flags & ITEM_VISIBLE) != !visible)) {
+    it->flags ^= ITEM_VISIBLE;
+    it->flags |= ITEM_CHANGED;
+  }
+}
+
+void RGBmatrixScene::touch(int8_t id) {
+  Item *it = item(id);
+
+  if (it)
+    it->flags |= ITEM_CHANGED;
+}
+
+void RGBmatrixScene::remove(int8_t id) {
+  Item *it = item(id);
+
+  if (it)
+    it->flags = (it->flags & ~ITEM_VISIBLE) | ITEM_CHANGED | ITEM_REMOVED;
+}
+
+// Nothing is on screen any more: every item is drawn afresh, and freed
+// ones can go at once.
+void RGBmatrixScene::invalidate(void) {
+  for (uint8_t i = 0; i < nItems; i++) {
+    items[i].drawn.w = 0;
+    items[i].flags |= ITEM_CHANGED;
+    if (items[i].flags & ITEM_REMOVED)
+      items[i].type = ITEM_FREE;
+  }
+  cleared = true;
+}
+
+void RGBmatrixScene::selectText(Adafruit_GFX *gfx, const Item *it) {
+  gfx->setFont((const GFXfont *)it->data);
+  gfx->setTextSize(it->size);
+  gfx->setTextWrap(false);
+}
+
+void RGBmatrixScene::bounds(Item *it, Box *b) {
+  uint16_t w, h;
+
+  b->w = 0; // Hidden: nothing
+  if (!(it->flags & ITEM_VISIBLE))
+    return;
+  switch (it->type) {
+  case ITEM_TEXT:
+    selectText(matrix, it);
+    matrix->getTextBounds(it->text, it->x, it->y, &b->x, &b->y, &w, &h);
+    b->w = w;
+    b->h = h;
+    break;
+  case ITEM_LINE: // Both ends included
+    b->x = min(it->x, it->x + it->w);
+    b->y = min(it->y, it->y + it->h);
+    b->w = abs(it->w) + 1;
+    b->h = abs(it->h) + 1;
+    break;
+  default:
+    b->x = it->x;
+    b->y = it->y;
+    b->w = it->w;
+    b->h = it->h;
+    break;
+  }
+}
+
+void RGBmatrixScene::draw(Adafruit_GFX *gfx, const Item *it, int16_t dx,
+                          int16_t dy) {
+  int16_t x = it->x + dx, y = it->y + dy;
+
+  switch (it->type) {
+  case ITEM_TEXT:
+    selectText(gfx, it);
+    gfx->setTextColor(it->color);
+    gfx->setCursor(x, y);
+    gfx->print(it->text);
+    break;
+  case ITEM_RECT:
+    if (it->size)
+      gfx->fillRect(x, y, it->w, it->h, it->color);
+    else
+      gfx->drawRect(x, y, it->w, it->h, it->color);
+    break;
+  case ITEM_LINE:
+    gfx->drawLine(x, y, x + it->w, y + it->h, it->color);
+    break;
+  case ITEM_BITMAP:
+    gfx->drawRGBBitmap(x, y, (const uint16_t *)it->data, it->w, it->h);
+    break;
+  }
+}
+
+boolean RGBmatrixScene::overlap(const Box *a, const Box *b) {
+  return (a->w > 0) && (a->h > 0) && (b->w > 0) && (b->h > 0) &&
+         (a->x < b->x + b->w) && (b->x < a->x + a->w) &&
+         (a->y < b->y + b->h) && (b->y < a->y + a->h);
+}
+
+uint8_t RGBmatrixScene::update(void) {
+  uint8_t i, j, n = 0;
+  boolean grown;
+  Item *it, *other;
+
+  // Where every item goes: changed ones are measured anew
+  for (i = 0; i < nItems; i++) {
+    it = &items[i];
+    if (it->type == ITEM_FREE)
+      continue;
+    if (it->flags & ITEM_CHANGED) {
+      bounds(it, &it->box);
+      it->flags |= ITEM_REDRAW;
+    } else {
+      it->box = it->drawn;
+    }
+  }
+
+  // Redraw whatever overlaps the old or new area of an item redrawn,
+  // until nothing more is drawn into
+  do {
+    grown = false;
+    for (i = 0; i < nItems; i++) {
+      it = &items[i];
+      if ((it->type == ITEM_FREE) || (it->flags & ITEM_REDRAW))
+        continue;
+      for (j = 0; j < nItems; j++) {
+        other = &items[j];
+        if ((other->flags & ITEM_REDRAW) &&
+            (overlap(&it->box, &other->drawn) ||
+             overlap(&it->box, &other->box))) {
+          it->flags |= ITEM_REDRAW;
+          grown = true;
+          break;
+        }
+      }
+    }
+  } while (grown);
+
+  // Clear what changed items leave behind, then draw in list order
+  if (cleared) {
+    matrix->fillScreen(background);
+    cleared = false;
+  } else {
+    for (i = 0; i < nItems; i++) {
+      it = &items[i];
+      if ((it->flags & ITEM_CHANGED) && (it->drawn.w > 0))
+        matrix->fillRect(it->drawn.x, it->drawn.y, it->drawn.w, it->drawn.h,
+                         background);
+    }
+  }
+  for (i = 0; i < nItems; i++) {
+    it = &items[i];
+    if (!(it->flags & ITEM_REDRAW))
+      continue;
+    if (it->flags & ITEM_REMOVED) {
+      it->type = ITEM_FREE;
+    } else if (it->box.w > 0) {
+      draw(matrix, it, 0, 0);
+      n++;
+    }
+    it->drawn = it->box;
+    it->flags &= ~(ITEM_CHANGED | ITEM_REDRAW);
+  }
+  return n;
+}
+
+// Bands run down the matrix's own (unrotated) rows, which is what
+// writeRow() takes.  The strip is as wide as those rows and is given the
+// matrix's rotation, so it covers the same screen area as the band once
+// items are moved by the band's top left corner (in rotated
+// coordinates): for rotations 2 and 3 the band's last row is on top.
+boolean RGBmatrixScene::render(uint8_t band) {
+  uint8_t rotation = matrix->getRotation(), i, r;
+  int16_t width = (rotation & 1) ? matrix->height() : matrix->width(),
+          height = (rotation & 1) ? matrix->width() : matrix->height(), top,
+          from, dx, dy;
+  GFXcanvas16 strip(width, band);
+  uint16_t *pixels = strip.getBuffer();
+  Item *it;
+  Box area;
+
+  if (!band || !pixels)
+    return false;
+  strip.setRotation(rotation);
+
+  // Every item is drawn as it is set now; removed ones go
+  for (i = 0; i < nItems; i++) {
+    it = &items[i];
+    if (it->flags & ITEM_REMOVED)
+      it->type = ITEM_FREE;
+    if (it->type == ITEM_FREE)
+      continue;
+    if (it->flags & ITEM_CHANGED)
+      bounds(it, &it->box);
+    else
+      it->box = it->drawn;
+  }
+
+  for (top = 0; top < height; top += band) {
+    from = (rotation & 2) ? (height - top - band) : top;
+    dx = (rotation & 1) ? -from : 0;
+    dy = (rotation & 1) ? 0 : -from;
+    area.x = -dx;
+    area.y = -dy;
+    area.w = strip.width();
+    area.h = strip.height();
+
+    strip.fillScreen(background);
+    for (i = 0; i < nItems; i++) {
+      it = &items[i];
+      if ((it->type != ITEM_FREE) && overlap(&it->box, &area))
+        draw(&strip, it, dx, dy);
+    }
+    for (r = 0; (r < band) && (top + r < height); r++)
+      matrix->writeRow(top + r, &pixels[r * width]);
+  }
+
+  for (i = 0; i < nItems; i++) {
+    items[i].drawn = items[i].box;
+    items[i].flags &= ~ITEM_CHANGED;
+  }
+  cleared = false;
+  return true;
+}
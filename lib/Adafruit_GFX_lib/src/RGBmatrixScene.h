@@ -0,0 +1,219 @@
+/*!
+ * @file RGBmatrixScene.h
+ *
+ * Retained display list for RGBmatrixPanel: a screen described as a list
+ * of items (text, rectangles, lines, bitmaps) which is redrawn only where
+ * items have changed since the last update.
+ *
+ */
+
+#ifndef RGBMATRIXSCENE_H
+#define RGBMATRIXSCENE_H
+
+#include "RGBmatrixPanel.h"
+
+#ifndef RGBMATRIX_SCENE_TEXT
+/*!
+  @brief  Characters kept per text item, terminator included (set from the
+          build flags to change).
+*/
+#define RGBMATRIX_SCENE_TEXT 16
+#endif
+
+/*!
+    @brief  Retained display list.  Items are added once and then changed
+            through the setters; update() works out what changed since the
+            last one and redraws only there: each changed item's old and
+            new area, and items overlapping those (in list order, so
+            later items stay on top).  The areas left by changed items
+            are filled with the background color.  The screen as a whole
+            is only cleared by the first update() and after invalidate().
+            Text is drawn with the matrix's text settings, which
+            update() changes.  With double buffering, swap with
+            swapBuffers(true) so that the back buffer keeps up with the
+            frames the changes are made against.  render() redraws the
+            whole list instead, composited a band of rows at a time.
+*/
+class RGBmatrixScene {
+
+public:
+  /*!
+    @brief  Constructor: allocate room for a number of items.
+    @param  matrix      Panel to draw on.
+    @param  size        Most items the list holds at once.
+    @param  background  Color of the screen where no item is.
+  */
+  RGBmatrixScene(RGBmatrixPanel *matrix, uint8_t size,
+                 uint16_t background = 0);
+  ~RGBmatrixScene(void);
+
+  /*!
+    @brief  Add a line of text.
+    @param  x      Cursor column, as for Adafruit_GFX::setCursor().
+    @param  y      Cursor row.
+    @param  str    Text, copied (up to RGBMATRIX_SCENE_TEXT - 1 characters).
+    @param  color  Text color (the background shows through).
+    @param  size   Text magnification.
+    @param  font   Font, or NULL for the built-in one.
+    @return Item number, or -1 if the list is full.
+  */
+  int8_t addText(int16_t x, int16_t y, const char *str, uint16_t color,
+                 uint8_t size = 1, const GFXfont *font = NULL);
+
+  /*!
+    @brief  Add a rectangle.
+    @param  x      Left column.
+    @param  y      Top row.
+    @param  w      Width, negative to extend left from x.
+    @param  h      Height, negative to extend up from y.
+    @param  color  Color.
+    @param  fill   true for a filled rectangle, false for an outline.
+    @return Item number, or -1 if the list is full or w or h is 0.
+  */
+  int8_t addRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color,
+                 boolean fill = true);
+
+  /*!
+    @brief  Add a line.  Moving it with moveTo() moves both ends.
+    @param  x0     Start column.
+    @param  y0     Start row.
+    @param  x1     End column.
+    @param  y1     End row.
+    @param  color  Color.
+    @return Item number, or -1 if the list is full.
+  */
+  int8_t addLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+
+  /*!
+    @brief  Add a 5/6/5 color bitmap held in PROGMEM, as drawn by
+            Adafruit_GFX::drawRGBBitmap().
+    @param  x       Left column.
+    @param  y       Top row.
+    @param  bitmap  Pixels, row by row.
+    @param  w       Width.
+    @param  h       Height.
+    @return Item number, or -1 if the list is full.
+  */
+  int8_t addBitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w,
+                   int16_t h);
+
+  /*!
+    @brief  Change a text item's text.  Unchanged text changes nothing.
+    @param  id   Item number.
+    @param  str  New text, copied.
+  */
+  void setText(int8_t id, const char *str);
+
+  /*!
+    @brief  Change an item's color (not a bitmap's).
+    @param  id     Item number.
+    @param  color  New color.
+  */
+  void setColor(int8_t id, uint16_t color);
+
+  /*!
+    @brief  Move an item: its cursor, top left corner or line start.
+    @param  id  Item number.
+    @param  x   New column.
+    @param  y   New row.
+  */
+  void moveTo(int8_t id, int16_t x, int16_t y);
+
+  /*!
+    @brief  Show or hide an item, keeping its place in the list.
+    @param  id       Item number.
+    @param  visible  true to show it.
+  */
+  void setVisible(int8_t id, boolean visible);
+
+  /*!
+    @brief  Have an item redrawn by the next update() though none of its
+            settings changed, e.g. after changing the bitmap it shows.
+    @param  id  Item number.
+  */
+  void touch(int8_t id);
+
+  /*!
+    @brief  Remove an item.  Its area is cleared by the next update(),
+            after which its number may be reused.
+    @param  id  Item number.
+  */
+  void remove(int8_t id);
+
+  /*!
+    @brief  Have the next update() clear the screen and redraw every item,
+            e.g. after drawing on the matrix outside the list.
+  */
+  void invalidate(void);
+
+  /*!
+    @brief  Bring the screen up to date with the list.
+    @return Number of items drawn.
+  */
+  uint8_t update(void);
+
+  /*!
+    @brief  Redraw the whole screen from the list through a strip canvas:
+            each band of matrix rows (unrotated) is cleared to the
+            background, every item crossing it is drawn there in list
+            order, and the result is written to the matrix with
+            RGBmatrixPanel::writeRow().  Items thus overlap as in full
+            color, and the matrix only sees finished rows -- without
+            double buffering, nothing half drawn is ever shown.  The
+            strip takes 2 bytes per pixel, allocated for the call only:
+            512 bytes at the default band of 4 rows on a 64-wide panel,
+            against 4 KB for a whole-screen GFXcanvas16.  Afterwards,
+            update() carries on from the screen rendered.
+    @param  band  Rows per band, 1 or more; more rows draw each item
+                  fewer times.
+    @return true on success, false if band is 0 or the strip could not be
+            allocated.
+  */
+  boolean render(uint8_t band = 4);
+
+private:
+  // Screen area, clipped to nothing when w or h is 0 or less.
+  typedef struct {
+    int16_t x, y, w, h;
+  } Box;
+
+  typedef struct {
+    uint8_t type;           ///< ITEM_* (see RGBmatrixScene.cpp)
+    uint8_t flags;          ///< ITEM_* flags
+    int16_t x, y;           ///< Cursor, top left corner or line start
+    int16_t w, h;           ///< Size, or line end relative to start
+    uint16_t color;         ///< Color (not for bitmaps)
+    uint8_t size;           ///< Text magnification, or rectangle filled
+    const void *data;       ///< Text font or bitmap pixels
+    char text[RGBMATRIX_SCENE_TEXT]; ///< Text
+    Box drawn;              ///< Area covered on screen now
+    Box box;                ///< Area to cover at the next update()
+  } Item;
+
+  // A free item, set up as a visible and changed one of the given type,
+  // or NULL if the list is full.
+  Item *newItem(uint8_t type, int16_t x, int16_t y, uint16_t color);
+
+  // Item numbered id if in use, else NULL.
+  Item *item(int8_t id);
+
+  // Select a text item's font and size for measuring or drawing.
+  void selectText(Adafruit_GFX *gfx, const Item *it);
+
+  // Area an item covers when drawn as it is set now.
+  void bounds(Item *it, Box *b);
+
+  // Draw an item as it is set now, moved by dx,dy.
+  void draw(Adafruit_GFX *gfx, const Item *it, int16_t dx, int16_t dy);
+
+  static boolean overlap(const Box *a, const Box *b);
+
+  RGBmatrixPanel *matrix; ///< Panel drawn on
+  Item *items;            ///< The list, or NULL if not allocated
+  uint8_t nItems;         ///< Items in the list, free ones included
+  uint16_t background;    ///< Color where no item is
+  boolean cleared;        ///< Whole screen to be cleared at next update()
+};
+
+#endif // RGBMATRIXSCENE_H
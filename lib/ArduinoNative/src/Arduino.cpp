@@ -0,0 +1,549 @@
+/**
+****************************************************************************************************
+*    @file           : Arduino.cpp
+*    @brief          : Arduino core API for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    Simulated ATmega2560 registers and pins, host clock timing, the stdin/stdout Serial
+*    port, Timer1 emulation and the program entry point.
+*
+*    Timer1 is emulated for the fast PWM modes with ICR1 as TOP (the only ones used here):
+*    while its overflow interrupt is enabled and the timer is clocked, a background thread
+*    calls TIMER1_OVF_vect() every (ICR1 + 1) * prescaler emulated CPU cycles, paced by the
+*    host clock at F_CPU. The handler runs between cli() and sei(), so code that disables
+*    interrupts on the main thread is never interrupted, as on the AVR. TCNT1 counts from
+*    each overflow in host time, so a handler can time itself; TOV1 is cleared on entry to
+*    the handler, as by the AVR, and set again if the handler reads TCNT1 past TOP. With its
+*    interrupt enabled, TIMER1_COMPB_vect() is called OCR1B timer ticks into each cycle
+*    (if OCR1B <= TOP); like the AVR in PWM modes, OCR1B is double-buffered, taking the
+*    value written at the overflow that starts the cycle. Writing TCNT1 other than from a
+*    Timer1 handler moves the next overflow to match, as an external interrupt handler
+*    restarting the timer would on the AVR; the handler's own writes leave the cycles paced
+*    by the host clock, so that host latencies do not add up.
+*
+*    External interrupts INT0-INT5 are run by simPinInput(), on the calling thread, when the
+*    level it sets makes the edge they were attached for. Pulse trains from simPinPulses()
+*    are timed by the host clock, like Timer1, so their rate against the refresh is exact.
+*
+****************************************************************************************************
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+
+/* Registers */
+SimPort PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG, PORTH, PORTJ, PORTK, PORTL;
+volatile uint8_t DDRA, DDRB, DDRC, DDRD, DDRE, DDRF, DDRG, DDRH, DDRJ, DDRK, DDRL;
+
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+volatile uint16_t ICR1, OCR1B;
+SimCounter TCNT1;
+
+HardwareSerial Serial;
+
+static SimPortHook port_hook = NULL;
+
+static std::mutex irq_lock;
+static thread_local bool irq_disabled = false;
+
+static volatile uint64_t timer1_cycles = 0;
+
+/* Host time when TCNT1 was last 0, in nanoseconds since start-up */
+static std::atomic<int64_t> timer1_zero(0);
+
+/* Overflow moved by a write to TCNT1 from outside the Timer1 handlers */
+static std::mutex timer1_mutex;
+static std::condition_variable timer1_moved;
+static std::chrono::steady_clock::time_point timer1_overflow;
+static bool timer1_written = false;
+static thread_local bool timer1_context = false;
+
+/* External interrupts and simulated input levels */
+#define EXTERNAL_INTERRUPTS 6
+
+static void (*volatile ext_handler[EXTERNAL_INTERRUPTS])(void);
+static volatile int ext_mode[EXTERNAL_INTERRUPTS];
+static volatile uint8_t pin_input[NUM_DIGITAL_PINS];
+static std::atomic<uint32_t> pin_pulses[NUM_DIGITAL_PINS];
+
+static const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+/* Pins: same PORT bits as the Arduino Mega 2560 */
+enum {
+  PA = 1, PB, PC, PD, PE, PF, PG, PH, PJ = 10, PK, PL
+};
+
+static SimPort *const port_to_output[] = {
+  NULL, &PORTA, &PORTB, &PORTC, &PORTD, &PORTE, &PORTF, &PORTG, &PORTH, NULL, &PORTJ, &PORTK,
+  &PORTL
+};
+
+static volatile uint8_t *const port_to_mode[] = {
+  NULL, &DDRA, &DDRB, &DDRC, &DDRD, &DDRE, &DDRF, &DDRG, &DDRH, NULL, &DDRJ, &DDRK, &DDRL
+};
+
+static const uint8_t digital_pin_to_port[NUM_DIGITAL_PINS] = {
+  PE, PE, PE, PE, PG, PE, PH, PH, PH, PH,   /* 0 - 9 */
+  PB, PB, PB, PB, PJ, PJ, PH, PH, PD, PD,   /* 10 - 19 */
+  PD, PD, PA, PA, PA, PA, PA, PA, PA, PA,   /* 20 - 29 */
+  PC, PC, PC, PC, PC, PC, PC, PC, PD, PG,   /* 30 - 39 */
+  PG, PG, PL, PL, PL, PL, PL, PL, PL, PL,   /* 40 - 49 */
+  PB, PB, PB, PB, PF, PF, PF, PF, PF, PF,   /* 50 - 59 */
+  PF, PF, PK, PK, PK, PK, PK, PK, PK, PK    /* 60 - 69 */
+};
+
+static const uint8_t digital_pin_to_bit[NUM_DIGITAL_PINS] = {
+  0, 1, 4, 5, 5, 3, 3, 4, 5, 6,             /* 0 - 9 */
+  4, 5, 6, 7, 1, 0, 1, 0, 3, 2,             /* 10 - 19 */
+  1, 0, 0, 1, 2, 3, 4, 5, 6, 7,             /* 20 - 29 */
+  7, 6, 5, 4, 3, 2, 1, 0, 7, 2,             /* 30 - 39 */
+  1, 0, 7, 6, 5, 4, 3, 2, 1, 0,             /* 40 - 49 */
+  3, 2, 1, 0, 0, 1, 2, 3, 4, 5,             /* 50 - 59 */
+  6, 7, 0, 1, 2, 3, 4, 5, 6, 7              /* 60 - 69 */
+};
+
+SimPort &SimPort::operator=(uint8_t value) {
+  uint8_t was = state;
+
+  state = value;
+  count++;
+  if (port_hook) {
+    port_hook(this, was);
+  }
+
+  return *this;
+}
+
+void SimPort::setHook(SimPortHook hook) {
+  port_hook = hook;
+}
+
+uint8_t digitalPinToPort(uint8_t pin) {
+  return (pin < NUM_DIGITAL_PINS) ? digital_pin_to_port[pin] : NOT_A_PORT;
+}
+
+uint8_t digitalPinToBitMask(uint8_t pin) {
+  return (pin < NUM_DIGITAL_PINS) ? _BV(digital_pin_to_bit[pin]) : 0;
+}
+
+SimPort *portOutputRegister(uint8_t port) {
+  return (port <= PL) ? port_to_output[port] : NULL;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  uint8_t port = digitalPinToPort(pin);
+
+  if (NOT_A_PORT == port) {
+    return;
+  }
+
+  if (OUTPUT == mode) {
+    *port_to_mode[port] |= digitalPinToBitMask(pin);
+  } else {
+    *port_to_mode[port] &= ~digitalPinToBitMask(pin);
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  SimPort *out = portOutputRegister(digitalPinToPort(pin));
+
+  if (NULL == out) {
+    return;
+  }
+
+  /* Same read-modify-write as the AVR core, with interrupts held off */
+  bool masked = irq_disabled;
+  cli();
+  if (LOW == val) {
+    *out &= ~digitalPinToBitMask(pin);
+  } else {
+    *out |= digitalPinToBitMask(pin);
+  }
+  if (!masked) {
+    sei();
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  uint8_t port = digitalPinToPort(pin);
+
+  if (NOT_A_PORT == port) {
+    return LOW;
+  }
+
+  /* Outputs read back what was written, inputs the level simulated */
+  if (*port_to_mode[port] & digitalPinToBitMask(pin)) {
+    return (*port_to_output[port] & digitalPinToBitMask(pin)) ? HIGH : LOW;
+  }
+
+  return pin_input[pin] ? HIGH : LOW;
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode) {
+  if (interruptNum < EXTERNAL_INTERRUPTS) {
+    cli();
+    ext_mode[interruptNum] = mode;
+    ext_handler[interruptNum] = userFunc;
+    sei();
+  }
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+  if (interruptNum < EXTERNAL_INTERRUPTS) {
+    cli();
+    ext_handler[interruptNum] = NULL;
+    sei();
+  }
+}
+
+void simPinInput(uint8_t pin, uint8_t level) {
+  int num = digitalPinToInterrupt(pin);
+  uint8_t was;
+  bool edge;
+
+  if (pin >= NUM_DIGITAL_PINS) {
+    return;
+  }
+
+  /* As an interrupt: held off while interrupts are disabled on another thread */
+  bool masked = irq_disabled;
+  cli();
+  was = pin_input[pin];
+  pin_input[pin] = (LOW != level);
+  if ((num >= 0) && (NULL != ext_handler[num])) {
+    switch (ext_mode[num]) {
+    case CHANGE:
+      edge = (was != pin_input[pin]);
+      break;
+    case FALLING:
+      edge = was && !pin_input[pin];
+      break;
+    case RISING:
+      edge = !was && pin_input[pin];
+      break;
+    default: /* LOW */
+      edge = !pin_input[pin];
+      break;
+    }
+    if (edge) {
+      ext_handler[num]();
+    }
+  }
+  if (!masked) {
+    sei();
+  }
+}
+
+static
+void pulse_thread(uint8_t pin, uint32_t train, double hz, unsigned long width_us) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  /* Each edge is timed from the start, so the rate does not drift with host latency */
+  for (uint64_t n = 1; pin_pulses[pin] == train; n++) {
+    std::this_thread::sleep_until(start + std::chrono::nanoseconds((int64_t)(n * 1e9 / hz)));
+    if (pin_pulses[pin] != train) {
+      break;
+    }
+    simPinInput(pin, HIGH);
+    std::this_thread::sleep_for(std::chrono::microseconds(width_us));
+    simPinInput(pin, LOW);
+  }
+}
+
+void simPinPulses(uint8_t pin, double hz, unsigned long width_us) {
+  if (pin >= NUM_DIGITAL_PINS) {
+    return;
+  }
+
+  /* Any train already running on the pin stops at its next pulse */
+  uint32_t train = ++pin_pulses[pin];
+  if (hz > 0.0) {
+    std::thread(pulse_thread, pin, train, hz, width_us).detach();
+  }
+}
+
+/* Interrupts */
+void cli(void) {
+  if (!irq_disabled) {
+    irq_lock.lock();
+    irq_disabled = true;
+  }
+}
+
+void sei(void) {
+  if (irq_disabled) {
+    irq_disabled = false;
+    irq_lock.unlock();
+  }
+}
+
+uint64_t simCycles(void) {
+  return timer1_cycles;
+}
+
+static
+uint32_t timer1_prescaler(void) {
+  static const uint16_t prescale[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+
+  return prescale[TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10))];
+}
+
+static
+int64_t host_nanos(void) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_time).count();
+}
+
+SimCounter &SimCounter::operator=(uint16_t value) {
+  timer1_zero = host_nanos() - (int64_t)value * timer1_prescaler() * 1000000000LL / F_CPU;
+
+  if (!timer1_context) {
+    uint32_t left = (value <= ICR1) ? (ICR1 + 1 - value) : (0x10000 - value);
+    std::lock_guard<std::mutex> lock(timer1_mutex);
+
+    timer1_overflow = std::chrono::steady_clock::now() + std::chrono::nanoseconds(
+        (uint64_t)left * timer1_prescaler() * 1000000000ULL / F_CPU);
+    timer1_written = true;
+    timer1_moved.notify_one();
+  }
+
+  return *this;
+}
+
+SimCounter::operator uint16_t() const {
+  uint32_t prescale = timer1_prescaler();
+  int64_t ticks;
+
+  if (0 == prescale) {
+    return 0;
+  }
+
+  ticks = (host_nanos() - timer1_zero) * (int64_t)(F_CPU / 1000) / 1000000 / prescale;
+  if (ticks > ICR1) {
+    TIFR1 |= _BV(TOV1);
+    ticks %= (int64_t)ICR1 + 1;
+  }
+
+  return (ticks < 0) ? 0 : ticks;
+}
+
+/* Sleep until the overflow, which a write to TCNT1 meanwhile moves; true if it moved */
+static
+bool timer1_sleep_until(std::chrono::steady_clock::time_point &overflow) {
+  std::unique_lock<std::mutex> lock(timer1_mutex);
+  bool moved = false;
+
+  for (;;) {
+    if (timer1_written) {
+      overflow = timer1_overflow;
+      timer1_written = false;
+      moved = true;
+    }
+    if ((std::cv_status::timeout == timer1_moved.wait_until(lock, overflow)) &&
+        !timer1_written) {
+      return moved;
+    }
+  }
+}
+
+static
+void timer1_thread(void) {
+  std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+  uint16_t ocr1b = OCR1B;
+
+  timer1_context = true;
+  for (;;) {
+    uint32_t prescale = timer1_prescaler();
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if ((NULL == TIMER1_OVF_vect) || !(TIMSK1 & _BV(TOIE1)) || (0 == prescale)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      next = std::chrono::steady_clock::now();
+      continue;
+    }
+
+    uint64_t cycles = ((uint64_t)ICR1 + 1) * prescale;
+    uint64_t start_cycles = timer1_cycles;
+    std::chrono::steady_clock::time_point begun = next;
+    next += std::chrono::nanoseconds(cycles * 1000000000ULL / F_CPU);
+    /* When the host falls behind, drop the backlog rather than racing to catch up */
+    if (next + std::chrono::milliseconds(10) < now) {
+      next = now;
+    }
+
+    /* Compare match B, part way through the cycle */
+    if ((NULL != TIMER1_COMPB_vect) && (TIMSK1 & _BV(OCIE1B)) && (ocr1b <= ICR1)) {
+      std::this_thread::sleep_until(next - std::chrono::nanoseconds(
+          (cycles - (uint64_t)ocr1b * prescale) * 1000000000ULL / F_CPU));
+
+      cli();
+      timer1_cycles = start_cycles + (uint64_t)ocr1b * prescale;
+      TIFR1 &= ~_BV(OCF1B); /* Cleared as the vector is taken */
+      TIMER1_COMPB_vect();
+      sei();
+    }
+
+    if (timer1_sleep_until(next)) {
+      cycles = (next > begun) ? (std::chrono::duration_cast<std::chrono::nanoseconds>(
+          next - begun).count() * (F_CPU / 1000) / 1000000) : 0;
+    }
+
+    cli();
+    timer1_cycles = start_cycles + cycles;
+    timer1_zero = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        next - start_time).count();
+    ocr1b = OCR1B; /* Double-buffered: updated at BOTTOM */
+    TIFR1 &= ~_BV(TOV1); /* Cleared as the vector is taken */
+    TIMER1_OVF_vect();
+    sei();
+  }
+}
+
+/* Time */
+unsigned long micros(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time).count();
+}
+
+unsigned long millis(void) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_time).count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+  /* Busy-wait, as on the AVR: this is also called from interrupt handlers */
+  std::chrono::steady_clock::time_point end =
+      std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+void yield(void) {
+  std::this_thread::yield();
+}
+
+/* Math */
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+long random(long howbig) {
+  return (howbig <= 0) ? 0 : (rand() % howbig);
+}
+
+long random(long howsmall, long howbig) {
+  return (howsmall >= howbig) ? howsmall : (howsmall + random(howbig - howsmall));
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) {
+    srand(seed);
+  }
+}
+
+/* Serial */
+void HardwareSerial::begin(__attribute__((unused)) unsigned long baud) {
+}
+
+bool HardwareSerial::fill(int timeout_ms) {
+  struct pollfd fds = {STDIN_FILENO, POLLIN, 0};
+  ssize_t n;
+
+  if (eof) {
+    return false;
+  }
+
+  /* Show any prompt before waiting for the answer */
+  fflush(stdout);
+
+  if (poll(&fds, 1, timeout_ms) <= 0) {
+    return false;
+  }
+
+  n = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+  if (n <= 0) {
+    eof = true;
+    return false;
+  }
+
+  head = 0;
+  tail = n;
+
+  return true;
+}
+
+int HardwareSerial::available(void) {
+  /* Waits up to 1 ms when there is no input, so an idle loop() does not spin */
+  if (head == tail) {
+    fill(1);
+  }
+
+  return tail - head;
+}
+
+int HardwareSerial::peek(void) {
+  if (!available()) {
+    return -1;
+  }
+
+  /* Line ends arrive as '\r', as from a serial terminal */
+  return ('\n' == buffer[head]) ? '\r' : buffer[head];
+}
+
+int HardwareSerial::read(void) {
+  int c = peek();
+
+  if (c >= 0) {
+    head++;
+  }
+
+  return c;
+}
+
+void HardwareSerial::flush(void) {
+  fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return (EOF == fputc(c, stdout)) ? 0 : 1;
+}
+
+bool HardwareSerial::finished(void) {
+  return eof && (head == tail);
+}
+
+/* Entry point */
+int main(void) {
+  const char *pulses = getenv("SIM_PULSES");
+  unsigned int pin;
+  double hz;
+
+  std::thread(timer1_thread).detach();
+  if (pulses && (2 == sscanf(pulses, "%u:%lf", &pin, &hz))) {
+    simPinPulses(pin, hz);
+  }
+
+  setup();
+  while (!Serial.finished()) {
+    loop();
+  }
+
+  /* Stop the interrupt thread before the sketch's objects go away */
+  cli();
+  fflush(stdout);
+  _exit(0);
+}
@@ -0,0 +1,172 @@
+/**
+****************************************************************************************************
+*    @file           : Arduino.h
+*    @brief          : Arduino core API for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    The subset of the Arduino AVR core used by the firmware and its libraries, implemented
+*    on top of the host C library so that the firmware can be built and run on a PC
+*    (PlatformIO "native" environment). The board simulated is an ATmega2560 (Arduino Mega):
+*    pin numbers map to the same PORT bits, the PORT registers record every write (see
+*    avr/io.h) and Timer1 runs its overflow interrupt from a background thread. An RGB
+*    matrix attached to the ports can be decoded into images with SimPanel.
+*
+*    Input pins read levels set with simPinInput(), which also runs the external interrupt
+*    attached to the pin, if any. simPinPulses() drives an input with a pulse train from a
+*    background thread, e.g. a camera's frame sync; SIM_PULSES=<pin>:<Hz> in the environment
+*    starts one before setup().
+*
+*    Serial reads stdin and writes stdout. The program exits when stdin is closed and all
+*    of its input has been consumed, so command scripts can be piped in.
+*
+****************************************************************************************************
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "binary.h"
+#include "avr/io.h"
+#include "avr/interrupt.h"
+#include "avr/pgmspace.h"
+
+#ifndef ARDUINO_ARCH_NATIVE
+#define ARDUINO_ARCH_NATIVE
+#endif
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define PI         3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define NOT_A_PIN  0
+#define NOT_A_PORT 0
+#define NOT_AN_INTERRUPT -1
+
+#define lowByte(w)  ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#define bitRead(value, bit)  (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)   ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bit(b)               (1UL << (b))
+
+#define noInterrupts() cli()
+#define interrupts()   sei()
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+/* Templates rather than the AVR core's macros, which clash with the C++ standard library */
+template <class T, class L>
+auto min(const T &a, const L &b) -> decltype((b < a) ? b : a) {
+  return (b < a) ? b : a;
+}
+
+template <class T, class L>
+auto max(const T &a, const L &b) -> decltype((b < a) ? b : a) {
+  return (a < b) ? b : a;
+}
+
+template <class T, class L, class H>
+T constrain(const T &x, const L &low, const H &high) {
+  return (x < low) ? low : ((x > high) ? high : x);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+/* Pins: ATmega2560 pin mapping, see Arduino.cpp */
+#define A0 54
+#define A1 55
+#define A2 56
+#define A3 57
+#define A4 58
+#define A5 59
+#define A6 60
+#define A7 61
+
+#define NUM_DIGITAL_PINS 70
+
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+SimPort *portOutputRegister(uint8_t port);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+/* External interrupts: INT0-INT5 on pins 2, 3, 21, 20, 19 and 18, as on the Mega */
+#define digitalPinToInterrupt(p) \
+  ((p) == 2 ? 0 : ((p) == 3 ? 1 : (((p) >= 18 && (p) <= 21) ? 23 - (p) : NOT_AN_INTERRUPT)))
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
+/* Simulated inputs: set the level read from a pin (running its interrupt on a matching edge),
+   or drive it with pulses of width_us at hz from a background thread (0 Hz stops them) */
+void simPinInput(uint8_t pin, uint8_t level);
+void simPinPulses(uint8_t pin, double hz, unsigned long width_us = 100);
+
+/* Time: host monotonic clock since start-up */
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+#include "WString.h"
+#include "Print.h"
+
+/* Serial port on stdin/stdout */
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baud);
+  void end(void) {}
+  int available(void);
+  int peek(void);
+  int read(void);
+  void flush(void);
+  size_t write(uint8_t c);
+  using Print::write;
+  operator bool() { return true; }
+
+  /* True once stdin is closed and every byte of it has been read */
+  bool finished(void);
+
+private:
+  bool fill(int timeout_ms);
+
+  uint8_t buffer[64];
+  size_t head = 0;
+  size_t tail = 0;
+  bool eof = false;
+};
+
+extern HardwareSerial Serial;
+
+/* Sketch entry points */
+void setup(void);
+void loop(void);
+
+#endif // Arduino_h
@@ -0,0 +1,149 @@
+/**
+****************************************************************************************************
+*    @file           : Print.cpp
+*    @brief          : Arduino Print base class for the host-native build
+****************************************************************************************************
+*/
+
+#include <Arduino.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+
+  while (size--) {
+    if (0 == write(*buffer++)) {
+      break;
+    }
+    n++;
+  }
+
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper *str) {
+  return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const String &str) {
+  return write(str.c_str(), str.length());
+}
+
+size_t Print::print(const char str[]) {
+  return write(str);
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(int n, int base) {
+  return print((long)n, base);
+}
+
+size_t Print::print(unsigned int n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(long n, int base) {
+  if (0 == base) {
+    return write((uint8_t)n);
+  }
+
+  if ((DEC == base) && (n < 0)) {
+    return print('-') + printNumber(-(unsigned long)n, DEC);
+  }
+
+  return printNumber((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  if (0 == base) {
+    return write((uint8_t)n);
+  }
+
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  char buf[48];
+
+  if (isnan(n)) {
+    return print("nan");
+  }
+  if (isinf(n)) {
+    return print("inf");
+  }
+  if ((n > 4294967040.0) || (n < -4294967040.0)) {
+    return print("ovf");
+  }
+
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+
+  return print(buf);
+}
+
+size_t Print::println(void) {
+  return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper *str) {
+  return print(str) + println();
+}
+
+size_t Print::println(const String &str) {
+  return print(str) + println();
+}
+
+size_t Print::println(const char str[]) {
+  return print(str) + println();
+}
+
+size_t Print::println(char c) {
+  return print(c) + println();
+}
+
+size_t Print::println(unsigned char n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(unsigned int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(unsigned long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(double n, int digits) {
+  return print(n, digits) + println();
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+
+  if (base < 2) {
+    base = 10;
+  }
+
+  *str = '\0';
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = (c < 10) ? (c + '0') : (c + 'A' - 10);
+  } while (n);
+
+  return write(str);
+}
@@ -0,0 +1,211 @@
+/**
+****************************************************************************************************
+*    @file           : SimPanel.cpp
+*    @brief          : Simulated HUB75 RGB matrix for the host-native build
+****************************************************************************************************
+*/
+
+#include "SimPanel.h"
+
+#define PIN_CLK  0
+#define PIN_LAT  1
+#define PIN_OE   2
+#define PIN_ADDR 3
+
+SimPanel simPanel;
+
+void SimPanel::begin(uint8_t width, uint8_t rows, SimPort *data, uint8_t clk, uint8_t lat,
+                     uint8_t oe, const uint8_t *addr) {
+  const uint8_t pins[PIN_ADDR] = {clk, lat, oe};
+
+  cli();
+
+  this->width = min(width, (uint8_t)SIMPANEL_MAX_WIDTH);
+  this->rows = min(rows, (uint8_t)SIMPANEL_MAX_ROWS);
+  dataport = data;
+
+  for (naddr = 0; (1 << naddr) < this->rows; naddr++) {
+    pinport[PIN_ADDR + naddr] = portOutputRegister(digitalPinToPort(addr[naddr]));
+    pinmask[PIN_ADDR + naddr] = digitalPinToBitMask(addr[naddr]);
+  }
+  for (uint8_t i = 0; i < PIN_ADDR; i++) {
+    pinport[i] = portOutputRegister(digitalPinToPort(pins[i]));
+    pinmask[i] = digitalPinToBitMask(pins[i]);
+  }
+
+  memset(shift, 0, sizeof(shift));
+  memset(columns, 0, sizeof(columns));
+  memset(ontime, 0, sizeof(ontime));
+  memset(rowtime, 0, sizeof(rowtime));
+  memset(image, 0, sizeof(image));
+  lit = false;
+  litrow = 0;
+  framestart = simCycles();
+  framelit = 0;
+  frame = 0;
+  ppm = getenv("PANELSIM_PPM");
+
+  SimPort::setHook(portWrite);
+
+  sei();
+}
+
+uint32_t SimPanel::frames(void) {
+  return frame;
+}
+
+uint8_t SimPanel::duty(void) {
+  return framelit;
+}
+
+uint32_t SimPanel::copyFrame(uint8_t *rgb) {
+  uint32_t n;
+
+  cli();
+  for (uint8_t y = 0; y < rows * 2; y++) {
+    memcpy(&rgb[y * width * 3], image[y], width * 3);
+  }
+  n = frame;
+  sei();
+
+  return n;
+}
+
+bool SimPanel::writePPM(const char *path) {
+  bool ok;
+
+  cli();
+  ok = save(path);
+  sei();
+
+  return ok;
+}
+
+bool SimPanel::save(const char *path) {
+  FILE *f = fopen(path, "wb");
+  bool ok = true;
+
+  if (NULL == f) {
+    return false;
+  }
+
+  fprintf(f, "P6\n%u %u\n255\n", width, rows * 2);
+  for (uint8_t y = 0; y < rows * 2; y++) {
+    ok &= (fwrite(image[y], 3, width, f) == width);
+  }
+
+  return (0 == fclose(f)) && ok;
+}
+
+bool SimPanel::pin(uint8_t n) {
+  return (*pinport[n] & pinmask[n]) != 0;
+}
+
+uint8_t SimPanel::address(void) {
+  uint8_t row = 0;
+
+  for (uint8_t i = 0; i < naddr; i++) {
+    if (pin(PIN_ADDR + i)) {
+      row |= 1 << i;
+    }
+  }
+
+  return row;
+}
+
+void SimPanel::portWrite(SimPort *port, uint8_t was) {
+  SimPanel &panel = simPanel;
+  uint8_t changed = was ^ *port;
+
+  if (NULL == panel.dataport) {
+    return;
+  }
+
+  /* Rising clock edge: shift the data lines in, first column first out at the far end */
+  if ((port == panel.pinport[PIN_CLK]) && (changed & panel.pinmask[PIN_CLK]) &&
+      panel.pin(PIN_CLK)) {
+    memmove(panel.shift, panel.shift + 1, panel.width - 1);
+    panel.shift[panel.width - 1] = *panel.dataport;
+  }
+
+  /* Latch, output enable and address lines all change what is lit */
+  for (uint8_t i = PIN_LAT; i < PIN_ADDR + panel.naddr; i++) {
+    if ((port == panel.pinport[i]) && (changed & panel.pinmask[i])) {
+      panel.light();
+      break;
+    }
+  }
+}
+
+void SimPanel::light(void) {
+  uint64_t now = simCycles();
+
+  /* Credit the time lit so far to the row that was lit */
+  if (lit && (now > litstart)) {
+    uint32_t t = now - litstart;
+
+    for (uint8_t x = 0; x < width; x++) {
+      for (uint8_t c = 0; c < 3; c++) {
+        if (columns[x] & (0x04 << c)) {
+          ontime[litrow][x][c] += t;
+        }
+        if (columns[x] & (0x20 << c)) {
+          ontime[litrow + rows][x][c] += t;
+        }
+      }
+    }
+    rowtime[litrow] += t;
+  }
+
+  if (pin(PIN_LAT)) {
+    memcpy(columns, shift, width);
+  }
+
+  lit = !pin(PIN_OE);
+  if (lit) {
+    uint8_t row = address();
+
+    /* Scan wrapped around: the frame is complete */
+    if (row < litrow) {
+      endFrame(now);
+    }
+    litrow = row;
+    litstart = now;
+  }
+}
+
+void SimPanel::endFrame(uint64_t now) {
+  bool changed = false;
+  uint64_t total = 0;
+
+  for (uint8_t y = 0; y < rows; y++) {
+    total += rowtime[y];
+  }
+  if (now > framestart) {
+    framelit = min((total * 255 + (now - framestart) / 2) / (now - framestart), (uint64_t)255);
+  }
+  framestart = now;
+
+  for (uint8_t y = 0; y < rows * 2; y++) {
+    uint32_t total = rowtime[y % rows];
+
+    for (uint8_t x = 0; x < width; x++) {
+      for (uint8_t c = 0; c < 3; c++) {
+        uint8_t v = total ? (((uint64_t)ontime[y][x][c] * 255 + total / 2) / total) : 0;
+
+        changed |= (v != image[y][x][c]);
+        image[y][x][c] = v;
+      }
+    }
+  }
+  memset(ontime, 0, sizeof(ontime));
+  memset(rowtime, 0, sizeof(rowtime));
+  frame++;
+
+  if (ppm && changed) {
+    char path[256];
+
+    snprintf(path, sizeof(path), "%s%05lu.ppm", ppm, (unsigned long)frame);
+    save(path);
+  }
+}
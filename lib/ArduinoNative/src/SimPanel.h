@@ -0,0 +1,105 @@
+/**
+****************************************************************************************************
+*    @file           : SimPanel.h
+*    @brief          : Simulated HUB75 RGB matrix for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    Follows the writes made to the simulated PORT registers the way a HUB75 panel follows
+*    its input lines, and decodes what is shown into RGB images:
+*      - each rising CLK edge shifts the 6 data bits (R1 G1 B1 R2 G2 B2, bits 2-7 of the
+*        data port) into the column shift register,
+*      - a rising LAT edge copies the shift register to the column drivers,
+*      - while OE is low the columns drive the row pair selected by the address lines; the
+*        time spent lit is measured in emulated CPU cycles (simCycles()).
+*    After every row has been scanned, each pixel's share of its row's lit time becomes its
+*    brightness (0-255) in a new frame image. How long the rows were lit against the
+*    frame's whole scan time, which dimming shortens, is kept as the frame's duty cycle.
+*
+*    If PANELSIM_PPM is set in the environment, each frame that differs from the one
+*    before is also written to "<PANELSIM_PPM>NNNNN.ppm".
+*
+****************************************************************************************************
+*/
+
+#ifndef SIM_PANEL_H
+#define SIM_PANEL_H
+
+#include <Arduino.h>
+
+#define SIMPANEL_MAX_WIDTH 64
+#define SIMPANEL_MAX_ROWS  32
+
+class SimPanel {
+public:
+  /**
+   * @brief Attach the panel to the simulated ports
+   * @param width Panel width in pixels
+   * @param rows Number of multiplexed rows (half the panel height)
+   * @param data PORT register holding the 6 data bits
+   * @param clk Clock pin
+   * @param lat Latch pin
+   * @param oe Output enable pin
+   * @param addr Address pins A, B, C... (log2(rows) of them)
+   */
+  void begin(uint8_t width, uint8_t rows, SimPort *data, uint8_t clk, uint8_t lat, uint8_t oe,
+             const uint8_t *addr);
+
+  /**
+   * @brief Number of frames decoded so far
+   */
+  uint32_t frames(void);
+
+  /**
+   * @brief Copy the last decoded frame
+   * @param rgb Destination, width * height * 3 bytes (R, G, B per pixel, rows top to bottom)
+   * @return Number of that frame (0 if none yet)
+   */
+  uint32_t copyFrame(uint8_t *rgb);
+
+  /**
+   * @brief Share of the last decoded frame's scan time that the LEDs were lit
+   * @return 0 (never lit) to 255 (lit throughout)
+   */
+  uint8_t duty(void);
+
+  /**
+   * @brief Write the last decoded frame as a binary PPM image
+   * @param path File name
+   * @return true on success
+   */
+  bool writePPM(const char *path);
+
+private:
+  static void portWrite(SimPort *port, uint8_t was);
+  bool save(const char *path);
+  bool pin(uint8_t n);
+  uint8_t address(void);
+  void light(void);
+  void endFrame(uint64_t now);
+
+  uint8_t width = 0;
+  uint8_t rows = 0;
+  uint8_t naddr = 0;
+  SimPort *dataport = NULL;
+  SimPort *pinport[3 + 5];
+  uint8_t pinmask[3 + 5];
+
+  uint8_t shift[SIMPANEL_MAX_WIDTH];
+  uint8_t columns[SIMPANEL_MAX_WIDTH];
+  bool lit = false;
+  uint8_t litrow = 0;
+  uint64_t litstart = 0;
+
+  uint32_t ontime[SIMPANEL_MAX_ROWS * 2][SIMPANEL_MAX_WIDTH][3];
+  uint32_t rowtime[SIMPANEL_MAX_ROWS];
+  uint8_t image[SIMPANEL_MAX_ROWS * 2][SIMPANEL_MAX_WIDTH][3];
+  uint64_t framestart = 0;
+  uint8_t framelit = 0;
+  uint32_t frame = 0;
+  const char *ppm = NULL;
+};
+
+extern SimPanel simPanel;
+
+#endif // SIM_PANEL_H
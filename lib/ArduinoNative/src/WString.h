@@ -0,0 +1,57 @@
+/**
+****************************************************************************************************
+*    @file           : WString.h
+*    @brief          : Arduino String class for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    The commonly used part of the Arduino String API, kept in a std::string.
+*
+****************************************************************************************************
+*/
+
+#ifndef String_class_h
+#define String_class_h
+
+#include <string>
+
+class String {
+public:
+  String(const char *str = "") : s(str ? str : "") {}
+  explicit String(char c) : s(1, c) {}
+  explicit String(int n) : s(std::to_string(n)) {}
+  explicit String(unsigned int n) : s(std::to_string(n)) {}
+  explicit String(long n) : s(std::to_string(n)) {}
+  explicit String(unsigned long n) : s(std::to_string(n)) {}
+
+  const char *c_str(void) const { return s.c_str(); }
+  unsigned int length(void) const { return s.length(); }
+  char charAt(unsigned int i) const { return (i < s.length()) ? s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+
+  bool concat(const String &str) { s += str.s; return true; }
+  bool concat(const char *str) { s += str ? str : ""; return true; }
+  bool concat(char c) { s += c; return true; }
+  String &operator+=(const String &str) { concat(str); return *this; }
+  String &operator+=(const char *str) { concat(str); return *this; }
+  String &operator+=(char c) { concat(c); return *this; }
+
+  bool equals(const String &str) const { return s == str.s; }
+  bool operator==(const String &str) const { return equals(str); }
+  bool operator!=(const String &str) const { return !equals(str); }
+
+  int indexOf(char c) const {
+    size_t i = s.find(c);
+    return (std::string::npos == i) ? -1 : (int)i;
+  }
+  String substring(unsigned int from) const { return substring(from, s.length()); }
+  String substring(unsigned int from, unsigned int to) const {
+    return (from < to && from < s.length()) ? String(s.substr(from, to - from).c_str()) : String();
+  }
+  long toInt(void) const { return atol(s.c_str()); }
+
+private:
+  std::string s;
+};
+
+#endif // String_class_h
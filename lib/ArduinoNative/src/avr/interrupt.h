@@ -0,0 +1,28 @@
+/**
+****************************************************************************************************
+*    @file           : avr/interrupt.h
+*    @brief          : Interrupt control for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    Interrupt handlers run on a background thread (see Arduino.cpp). cli() holds them off
+*    until the next sei(), as on the AVR: the calls do not nest.
+*
+****************************************************************************************************
+*/
+
+#ifndef _AVR_INTERRUPT_H_
+#define _AVR_INTERRUPT_H_
+
+#define ISR_BLOCK
+
+#define ISR(vector, ...) extern "C" void vector(void)
+
+/* Vectors that can be emulated; see Arduino.cpp */
+extern "C" void TIMER1_OVF_vect(void) __attribute__((weak));
+extern "C" void TIMER1_COMPB_vect(void) __attribute__((weak));
+
+void cli(void);
+void sei(void);
+
+#endif // _AVR_INTERRUPT_H_
@@ -0,0 +1,82 @@
+/**
+****************************************************************************************************
+*    @file           : avr/io.h
+*    @brief          : Simulated ATmega2560 I/O registers for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    PORT registers are SimPort objects: they read and write like the 8-bit registers they
+*    stand in for, but count each write and report it to an optional hook, which is how
+*    SimPanel follows the signals sent to an attached RGB matrix. Data direction and Timer1
+*    control registers are plain variables; Timer1 is emulated in Arduino.cpp, and its
+*    counter (TCNT1) reads the host time elapsed, in timer ticks.
+*
+****************************************************************************************************
+*/
+
+#ifndef _AVR_IO_H_
+#define _AVR_IO_H_
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+class SimPort;
+
+/* Called after every write to any PORT register, with the register's previous value */
+typedef void (*SimPortHook)(SimPort *port, uint8_t was);
+
+class SimPort {
+public:
+  SimPort &operator=(uint8_t value);
+  SimPort &operator|=(uint8_t bits) { return *this = state | bits; }
+  SimPort &operator&=(uint8_t bits) { return *this = state & bits; }
+  SimPort &operator^=(uint8_t bits) { return *this = state ^ bits; }
+  operator uint8_t() const { return state; }
+
+  /* Number of writes made to the register */
+  uint32_t writes(void) const { return count; }
+
+  static void setHook(SimPortHook hook);
+
+private:
+  volatile uint8_t state = 0;
+  uint32_t count = 0;
+};
+
+extern SimPort PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG, PORTH, PORTJ, PORTK, PORTL;
+extern volatile uint8_t DDRA, DDRB, DDRC, DDRD, DDRE, DDRF, DDRG, DDRH, DDRJ, DDRK, DDRL;
+
+/* Timer1 counter: timer ticks (host time at F_CPU over the prescaler) since it was written or
+   last overflowed, counting up to TOP (ICR1). A read past TOP wraps and sets TOV1 in TIFR1. */
+class SimCounter {
+public:
+  SimCounter &operator=(uint16_t value);
+  operator uint16_t() const;
+};
+
+/* Timer1 */
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+extern volatile uint16_t ICR1, OCR1B;
+extern SimCounter TCNT1;
+
+#define WGM10 0
+#define WGM11 1
+#define CS10  0
+#define CS11  1
+#define CS12  2
+#define WGM12 3
+#define WGM13 4
+#define TOIE1  0
+#define OCIE1B 2
+#define TOV1   0
+#define OCF1B  2
+
+/* Emulated CPU clock cycles counted by Timer1 since start-up */
+uint64_t simCycles(void);
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#endif // _AVR_IO_H_
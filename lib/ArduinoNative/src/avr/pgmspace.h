@@ -0,0 +1,38 @@
+/**
+****************************************************************************************************
+*    @file           : avr/pgmspace.h
+*    @brief          : Program memory access for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    The host has a single address space, so PROGMEM data is ordinary const data.
+*
+****************************************************************************************************
+*/
+
+#ifndef __PGMSPACE_H_
+#define __PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr)   (*(void *const *)(addr))
+
+#define memcpy_P     memcpy
+#define strcpy_P     strcpy
+#define strncpy_P    strncpy
+#define strcmp_P     strcmp
+#define strncmp_P    strncmp
+#define strcasecmp_P strcasecmp
+#define strlen_P     strlen
+
+#endif // __PGMSPACE_H_
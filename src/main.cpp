@@ -33,10 +33,16 @@
 #include "serial_logger.h"
 #include "cmd.h"
 
-#define NUMBER_OF_COMMANDS    7
+#define NUMBER_OF_COMMANDS    23
 
 #define MATRIX_WIDTH          64
 
+/* Glyph cell of the built-in 5x7 font at text size 1, spacing included */
+#define CHAR_WIDTH            6
+#define CHAR_HEIGHT           8
+
+#define BENCHMARK_ITERATIONS  100
+
 #define CLK                   (uint8_t)11
 #define OE                    (uint8_t)9
 #define LAT                   (uint8_t)10
@@ -67,6 +73,9 @@ void run_countdown_tests(Cmd *thisCmd, char *command, bool printHelp);
 static
 void run_scrolling_text_test(Cmd *thisCmd, char *command, bool printHelp);
 
+static
+void run_ticker_test(Cmd *thisCmd, char *command, bool printHelp);
+
 static
 void run_fill_screen_test(Cmd *thisCmd, char *command, bool printHelp);
 
@@ -79,6 +88,51 @@ void run_horizontal_line_test(Cmd *thisCmd, char *command, bool printHelp);
 static
 void run_grid_generatior_test(Cmd *thisCmd, char *command, bool printHelp);
 
+static
+void run_gradient_test(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void run_draw_benchmark(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void print_frame_crc(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void print_stats(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_addr_delay(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void run_addr_delay_benchmark(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_brightness(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_refresh_lock(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_vsync(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_present_pin(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void print_present_log(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_dither(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_blank_rows(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_pattern(Cmd *thisCmd, char *command, bool printHelp);
+
+static
+void set_clip(Cmd *thisCmd, char *command, bool printHelp);
+
 static
 void fill_screen(text_color_t_en color, uint32_t delay_ms);
 
@@ -215,11 +269,27 @@ void print_help(Cmd *thisCmd, char *command, bool printHelp) {
 	Serial.print("Available commands:\r\n\r\n");
   Serial.print("\thelp: \t\t\t\t\t\t\t Shows this help message\r\n");
   Serial.print("\trun_scrolling_text_test <delay_ms>: \t\t\t Runs a scrolling text test\r\n");
+  Serial.print("\trun_ticker_test <delay_ms>: \t\t\t\t Runs a line feed (vertical scroll) text test\r\n");
   Serial.print("\trun_countdown_test <countdown_seconds> <delay_ms>: \t Runs a countdown test with specified delay\r\n");
   Serial.print("\trun_fill_screen_test <delay_ms>: \t\t\t Fills the screen with each color\r\n");
   Serial.print("\trun_vertical_line_test: \t\t\t\t Runs a vertical line test\r\n");
   Serial.print("\trun_horizontal_line_test: \t\t\t\t Runs a horizontal line test\r\n");
   Serial.print("\trun_grid_generatior_test: \t\t\t\t Runs a grid generatior test\r\n");
+  Serial.print("\trun_gradient_test: \t\t\t\t\t Shows gray, red, green and blue ramps in 5/6/5 steps\r\n");
+  Serial.print("\trun_draw_benchmark [iterations]: \t\t\t Times generic vs native line/rect/canvas drawing\r\n");
+  Serial.print("\tframe_crc: \t\t\t\t\t\t Prints the CRC-16 of the frame read back from the display buffer\r\n");
+  Serial.print("\tstats: \t\t\t\t\t\t\t Prints refresh interrupt statistics since the last call\r\n");
+  Serial.print("\taddr_delay [us]: \t\t\t\t\t Shows or sets the row address settle time (0-100 us)\r\n");
+  Serial.print("\trun_addr_delay_benchmark: \t\t\t\t Measures refresh rate for several address settle times\r\n");
+  Serial.print("\tbrightness [0-255]: \t\t\t\t\t Shows or sets the display brightness (255 = full)\r\n");
+  Serial.print("\trefresh_lock [fps]: \t\t\t\t\t Shows the refresh rate or locks it to a camera frame rate (0 = free-running)\r\n");
+  Serial.print("\tvsync [pin [window_us] | off]: \t\t\t\t Shows sync status, or phase-locks the refresh to a camera VSYNC pin\r\n");
+  Serial.print("\tpresent_pin [pin | off]: \t\t\t\t Toggles a pin as each swapped frame goes on display\r\n");
+  Serial.print("\tpresent_log: \t\t\t\t\t\t Prints when swapped frames went on display since the last call\r\n");
+  Serial.print("\tdither [on | off]: \t\t\t\t\t Shows or sets temporal dithering (one more bit per color)\r\n");
+  Serial.print("\tblank_rows [scan | idle | fast]: \t\t\t Shows or sets how all-black rows are refreshed\r\n");
+  Serial.print("\tpattern [grid | stripes | checker | gradient | sweep | off]: Shows or sets a pattern generated by the refresh\r\n");
+  Serial.print("\tclip [x y w h | off]: \t\t\t\t\t Shows or sets the rectangle drawing is confined to\r\n");
   Serial.print("\r\n");
 
 	return;
@@ -254,7 +324,8 @@ void unrecognized_command(Cmd *thisCmd, char *command, bool printHelp) {
 static
 void run_countdown_tests(Cmd *thisCmd, char *command, bool printHelp) {
   led_matrix_status_t ret = LED_MATRIX_SUCCESS;
-  text_params_t_st params = {0};
+  RGBmatrixScene scene(&matrix, 1, COLOR_BLACK);
+  int8_t digits = -1;
   char buffer[4];
   char *parsed = NULL;
   uint32_t seconds = 0, delay_ms = 0;
@@ -301,31 +372,23 @@ void run_countdown_tests(Cmd *thisCmd, char *command, bool printHelp) {
     return;
   }
 
-  params.x = 27;
-  params.y = 11;
-  params.f = NULL;
-  params.color = COLOR_MAGENTA;
-  params.pixels_size = SIZE_1_PIXEL;
+  /* The count is the one item on screen: each update redraws its old and new area only */
+  digits = scene.addText(27, 11, "", COLOR_MAGENTA, SIZE_1_PIXEL);
+  if (digits < 0) {
+    LOG_ERROR("Failed to allocate the countdown display list.");
+
+    return;
+  }
 
-  LOG_DEBUG("Running countdown test with seconds=%ld and delay_ms=%ld...", seconds, delay_ms);
+  LOG_DEBUG("Running countdown test with seconds=%lu and delay_ms=%lu...", (unsigned long)seconds, (unsigned long)delay_ms);
 
   for (int i = seconds; i >= 0; i--) {
-    /* Clear display */
-    matrix.fillScreen(COLOR_BLACK);
-
     /* Prepare string */
     snprintf(buffer, sizeof(buffer), "%02d", i);
 
-    /* Update string in parameters */
-    params.str = buffer;
-
-    /* Print text */
-    ret = matrix_print_text(&params);
-    if (LED_MATRIX_SUCCESS != ret) {
-      LOG_ERROR("Failed to print countdown text on the LED matrix panel.");
-
-      return;
-    }
+    /* Update string in the display list and redraw it */
+    scene.setText(digits, buffer);
+    scene.update();
 
     /* Wait for 1 second */
     delay(delay_ms);
@@ -434,8 +497,9 @@ void run_scrolling_text_test(Cmd *thisCmd, char *command, bool printHelp) {
   text_params_t_st params = {0};
   const char *str = "This is a long text scrolling across the screen to test RVC and MVC camera recording.";
   size_t str_len = strlen(str);
-  int16_t x_start = 64;
-  int16_t x_end = -((int16_t)str_len * 6);
+  int16_t x_start = MATRIX_WIDTH;
+  int16_t x_end = -((int16_t)str_len * CHAR_WIDTH);
+  int16_t col = 0;
 
   char *parsed = NULL;
   uint32_t delay_ms = 0;
@@ -465,38 +529,117 @@ void run_scrolling_text_test(Cmd *thisCmd, char *command, bool printHelp) {
   params.f = NULL;
   params.color = COLOR_RED;
   params.pixels_size =SIZE_1_PIXEL;
-  params.str = (char *)str;
 
   matrix.setTextWrap(false);
+  matrix.setTextSize(params.pixels_size);
+  matrix.setFont(params.f);
+
+  LOG_DEBUG("Running running text test with delay_ms=%lu...", (unsigned long)delay_ms);
 
-  LOG_DEBUG("Running running text test with delay_ms=%ld...", delay_ms);
+  /* Clear display */
+  matrix.fillScreen(COLOR_BLACK);
 
   for (size_t i = 0; i < 3; i++) {
     for (int16_t x = x_start; x >= x_end; x--) {
-      /* Clear display */
-      matrix.fillScreen(COLOR_BLACK);
+      /* Shift the text band one pixel left, blanking the right-most column */
+      matrix.scrollRect(0, params.y, MATRIX_WIDTH, CHAR_HEIGHT, -1, COLOR_BLACK);
+
+      /* Draw the character that has just scrolled into that column */
+      col = MATRIX_WIDTH - 1 - x;
+      if ((col >= 0) && (col < (int16_t)str_len * CHAR_WIDTH)) {
+        matrix.drawChar(x + (col / CHAR_WIDTH) * CHAR_WIDTH, params.y, str[col / CHAR_WIDTH],
+                        params.color, params.color, params.pixels_size);
+      }
+
+      /* Wait */
+      delay(delay_ms);
+    }
+  }
 
-      params.x = x;
+  ret = print_test_completed();
+  if (LED_MATRIX_SUCCESS != ret) {
+    LOG_ERROR("Failed to print 'Test Completed' on the LED matrix panel.");
+  }
 
-      /* Print text */
-      ret = matrix_print_text(&params);
-      if (LED_MATRIX_SUCCESS != ret) {
-        LOG_ERROR("Failed to print scrolling text on the LED matrix panel.");
+  LOG_DEBUG("Running text test complete.");
 
-        return;
-      }
+  delay(2000);
+  matrix.fillScreen(COLOR_BLACK);
+}
+
+/**
+ * @brief Run ticker test on the LED matrix panel: lines of text fed in from the bottom
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void run_ticker_test(Cmd *thisCmd, char *command, bool printHelp) {
+  led_matrix_status_t ret = LED_MATRIX_SUCCESS;
+  const char *lines[] = {"Ticker", "test for", "RVC and", "MVC", "camera", "recording"};
+  int16_t y_last = 0;
+
+  char *parsed = NULL;
+  uint32_t delay_ms = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for run_ticker_test command.");
+
+    return;
+  }
+
+  /*Parse the next available argument. */
+  parsed = cmd->Parse();
+  if (parsed == NULL) {
+    LOG_ERROR("Invalid delay_ms");
+
+    return;
+  }
+  /* Parse integer. */
+  delay_ms = atoi(parsed);
+  if (delay_ms < 1 || delay_ms > 500) {
+    LOG_ERROR("Delay_ms must be between 1 and 500.");
+
+    return;
+  }
+
+  matrix.setTextWrap(false);
+  matrix.setTextSize(SIZE_1_PIXEL);
+  matrix.setFont(NULL);
+  matrix.setTextColor(COLOR_GREEN);
+
+  LOG_DEBUG("Running ticker test with delay_ms=%lu...", (unsigned long)delay_ms);
+
+  /* Clear display */
+  matrix.fillScreen(COLOR_BLACK);
+
+  y_last = matrix.height() - 1;
+  for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    for (int16_t y = 0; y < CHAR_HEIGHT; y++) {
+      /* Move everything up a row, blanking the bottom row */
+      matrix.scrollRows(-1, COLOR_BLACK);
+
+      /* Draw the incoming line with its next row on the bottom row; the rows above are unchanged */
+      matrix.setCursor(1, y_last - y);
+      matrix.print(lines[i]);
 
       /* Wait */
       delay(delay_ms);
     }
   }
 
+  /* Feed blank rows until the last line has gone */
+  for (int16_t y = 0; y < matrix.height(); y++) {
+    matrix.scrollRows(-1, COLOR_BLACK);
+    delay(delay_ms);
+  }
+
   ret = print_test_completed();
   if (LED_MATRIX_SUCCESS != ret) {
     LOG_ERROR("Failed to print 'Test Completed' on the LED matrix panel.");
   }
 
-  LOG_DEBUG("Running text test complete.");
+  LOG_DEBUG("Ticker test complete.");
 
   delay(2000);
   matrix.fillScreen(COLOR_BLACK);
@@ -535,7 +678,7 @@ void run_fill_screen_test(Cmd *thisCmd, char *command, bool printHelp) {
     return;
   }
 
-  LOG_DEBUG("Running fill screen color test with delay_ms=%ld...", delay_ms);
+  LOG_DEBUG("Running fill screen color test with delay_ms=%lu...", (unsigned long)delay_ms);
 
   for (size_t i = 0; i < 3; i++)
   {
@@ -579,8 +722,6 @@ void run_fill_screen_test(Cmd *thisCmd, char *command, bool printHelp) {
  */
 static
 void run_grid_generatior_test(Cmd *thisCmd, char *command, bool printHelp) {
-  led_matrix_status_t ret = LED_MATRIX_SUCCESS;
-
   if (NULL == thisCmd || NULL == command) {
     LOG_ERROR("Invalid arguments for run_fill_screen_test command.");
 
@@ -600,6 +741,898 @@ void run_grid_generatior_test(Cmd *thisCmd, char *command, bool printHelp) {
   LOG_DEBUG("Done grid generation test.");
 }
 
+/**
+ * @brief Run gradient test on the LED matrix panel. Fill matrix with gray, red, green and blue
+ *        horizontal bands, each ramping from black at the left to full at the right in 5/6/5 steps
+ *        (finer than the panel's own color depth, see the dither command).
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void run_gradient_test(Cmd *thisCmd, char *command, bool printHelp) {
+  int16_t band = matrix.height() / 4;
+  uint16_t r5 = 0;
+  uint16_t g6 = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for run_gradient_test command.");
+
+    return;
+  }
+
+  LOG_DEBUG("Running gradient test...");
+  for (int16_t x = 0; x < matrix.width(); x++) {
+    r5 = (x * 32) / matrix.width();
+    g6 = (x * 64) / matrix.width();
+    matrix.drawFastVLine(x, 0, band, (r5 << 11) | (g6 << 5) | r5);
+    matrix.drawFastVLine(x, band, band, r5 << 11);
+    matrix.drawFastVLine(x, band * 2, band, g6 << 5);
+    matrix.drawFastVLine(x, band * 3, matrix.height() - band * 3, r5);
+  }
+
+  LOG_DEBUG("Done gradient test.");
+}
+
+static
+void bench_hline_generic(uint16_t i) {
+  matrix.Adafruit_GFX::drawFastHLine(0, i % matrix.height(), MATRIX_WIDTH, COLOR_BLUE);
+}
+
+static
+void bench_hline_native(uint16_t i) {
+  matrix.drawFastHLine(0, i % matrix.height(), MATRIX_WIDTH, COLOR_BLUE);
+}
+
+static
+void bench_vline_generic(uint16_t i) {
+  matrix.Adafruit_GFX::drawFastVLine(i % MATRIX_WIDTH, 0, matrix.height(), COLOR_GREEN);
+}
+
+static
+void bench_vline_native(uint16_t i) {
+  matrix.drawFastVLine(i % MATRIX_WIDTH, 0, matrix.height(), COLOR_GREEN);
+}
+
+static
+void bench_fill_rect_generic(uint16_t i) {
+  int16_t x = (i * 8) % MATRIX_WIDTH;
+
+  /* Same per-pixel path Adafruit_GFX::fillRect used before the override */
+  for (int16_t dx = 0; dx < 8; dx++) {
+    matrix.Adafruit_GFX::drawFastVLine(x + dx, 0, matrix.height(), COLOR_YELLOW);
+  }
+}
+
+static
+void bench_fill_rect_native(uint16_t i) {
+  matrix.fillRect((i * 8) % MATRIX_WIDTH, 0, 8, matrix.height(), COLOR_YELLOW);
+}
+
+static
+void bench_fill_screen_generic(uint16_t i) {
+  /* Same per-pixel path Adafruit_GFX::fillScreen used for non black/white colors */
+  for (int16_t y = 0; y < matrix.height(); y++) {
+    for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+      matrix.drawPixel(x, y, (i & 1) ? COLOR_MAGENTA : COLOR_CYAN);
+    }
+  }
+}
+
+static
+void bench_fill_screen_native(uint16_t i) {
+  matrix.fillScreen((i & 1) ? COLOR_MAGENTA : COLOR_CYAN);
+}
+
+/* Off-screen canvases for the blit cases, allocated by run_draw_benchmark() for its run only */
+static GFXcanvas16 *bench_canvas16 = NULL;
+static GFXcanvas1 *bench_canvas1 = NULL;
+
+static
+void bench_canvas16_generic(uint16_t i) {
+  matrix.drawRGBBitmap(0, (i * 8) % matrix.height(), bench_canvas16->getBuffer(),
+                       MATRIX_WIDTH, bench_canvas16->height());
+}
+
+static
+void bench_canvas16_native(uint16_t i) {
+  matrix.drawCanvas(0, (i * 8) % matrix.height(), bench_canvas16);
+}
+
+static
+void bench_canvas1_generic(uint16_t i) {
+  matrix.drawBitmap(0, 0, bench_canvas1->getBuffer(), MATRIX_WIDTH, bench_canvas1->height(),
+                    COLOR_WHITE, (i & 1) ? COLOR_BLUE : COLOR_RED);
+}
+
+static
+void bench_canvas1_native(uint16_t i) {
+  matrix.drawCanvas(0, 0, bench_canvas1, COLOR_WHITE, (i & 1) ? COLOR_BLUE : COLOR_RED);
+}
+
+/**
+ * @brief Time a drawing function over a number of iterations
+ * @param draw Drawing function, called with the iteration index
+ * @param iterations Number of calls
+ * @return Total elapsed time in microseconds
+ */
+static
+uint32_t benchmark_run(void (*draw)(uint16_t i), uint16_t iterations) {
+  uint32_t start = micros();
+
+  for (uint16_t i = 0; i < iterations; i++) {
+    draw(i);
+  }
+
+  return micros() - start;
+}
+
+/**
+ * @brief Compare the per-pixel Adafruit_GFX drawing path against the RGBmatrixPanel span writers
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void run_draw_benchmark(Cmd *thisCmd, char *command, bool printHelp) {
+  static const benchmark_case_t_st cases[] = {
+    { "drawFastHLine", bench_hline_generic,       bench_hline_native       },
+    { "drawFastVLine", bench_vline_generic,       bench_vline_native       },
+    { "fillRect 8xH",  bench_fill_rect_generic,   bench_fill_rect_native   },
+    { "fillScreen",    bench_fill_screen_generic, bench_fill_screen_native },
+    { "canvas16 Wx8",  bench_canvas16_generic,    bench_canvas16_native    },
+    { "canvas1 WxH",   bench_canvas1_generic,     bench_canvas1_native     },
+  };
+  GFXcanvas16 canvas16(MATRIX_WIDTH, 8);
+  GFXcanvas1 canvas1(MATRIX_WIDTH, matrix.height());
+  char *parsed = NULL;
+  uint32_t iterations = BENCHMARK_ITERATIONS;
+  uint32_t generic_us = 0, native_us = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for run_draw_benchmark command.");
+
+    return;
+  }
+
+  /* Iterations argument is optional */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    iterations = atoi(parsed);
+    if (iterations < 1 || iterations > 10000) {
+      LOG_ERROR("Iterations must be between 1 and 10000.");
+
+      return;
+    }
+  }
+
+  if (NULL == canvas16.getBuffer() || NULL == canvas1.getBuffer()) {
+    LOG_ERROR("Not enough RAM for the benchmark canvases.");
+
+    return;
+  }
+
+  /* Canvas contents: a full color ramp, and text */
+  for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+    canvas16.drawFastVLine(x, 0, canvas16.height(), matrix.ColorHSV(x * 1536L / MATRIX_WIDTH, 255, 255, true));
+  }
+  canvas1.setCursor(1, 1);
+  canvas1.print("Blit test");
+  bench_canvas16 = &canvas16;
+  bench_canvas1 = &canvas1;
+
+  LOG_DEBUG("Running draw benchmark with iterations=%lu...", (unsigned long)iterations);
+
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    matrix.fillScreen(COLOR_BLACK);
+    generic_us = benchmark_run(cases[i].generic, iterations);
+
+    matrix.fillScreen(COLOR_BLACK);
+    native_us = benchmark_run(cases[i].native, iterations);
+
+    Serial.print(cases[i].name);
+    Serial.print(": generic ");
+    Serial.print(generic_us);
+    Serial.print(" us, native ");
+    Serial.print(native_us);
+    Serial.print(" us, speedup x");
+    Serial.println(native_us ? (float)generic_us / native_us : 0.0f, 1);
+  }
+
+  bench_canvas16 = NULL;
+  bench_canvas1 = NULL;
+  matrix.fillScreen(COLOR_BLACK);
+
+  LOG_DEBUG("Draw benchmark complete.");
+}
+
+/**
+ * @brief Update a CRC-16/CCITT-FALSE checksum with one byte
+ * @param crc Checksum so far (0xFFFF to start)
+ * @param data Next byte
+ * @return Updated checksum
+ */
+static
+uint16_t crc16_update(uint16_t crc, uint8_t data) {
+  crc ^= (uint16_t)data << 8;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+  }
+
+  return crc;
+}
+
+/**
+ * @brief Print the CRC-16 of the frame in the display buffer, read back row by row
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void print_frame_crc(Cmd *thisCmd, char *command, bool printHelp) {
+  uint16_t row[MATRIX_WIDTH];
+  uint16_t crc = 0xFFFF;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for frame_crc command.");
+
+    return;
+  }
+
+  /* 5/6/5 colors, high byte first, rows top to bottom */
+  for (int16_t y = 0; y < matrix.height(); y++) {
+    matrix.readRow(y, row);
+    for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+      crc = crc16_update(crc, row[x] >> 8);
+      crc = crc16_update(crc, row[x] & 0xFF);
+    }
+  }
+
+  Serial.print("Frame CRC-16: 0x");
+  Serial.println(crc, HEX);
+}
+
+/**
+ * @brief Print refresh interrupt statistics gathered since the last call (needs RGBMATRIX_STATS)
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void print_stats(Cmd *thisCmd, char *command, bool printHelp) {
+#ifdef RGBMATRIX_STATS
+  RGBmatrixStats stats;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for stats command.");
+
+    return;
+  }
+
+  matrix.getStats(&stats, true);
+  if (0 == stats.ticks) {
+    LOG_ERROR("No refresh interrupts since the last call.");
+
+    return;
+  }
+
+  Serial.print("Interval: ");
+  Serial.print(stats.ticks / (F_CPU / 1000UL));
+  Serial.println(" ms");
+  Serial.print("Interrupts: ");
+  Serial.println(stats.interrupts);
+  Serial.print("Frames: ");
+  Serial.print(stats.frames);
+  Serial.print(" (");
+  Serial.print((double)stats.frames * F_CPU / stats.ticks, 1);
+  Serial.println(" Hz)");
+  Serial.print("CPU load: ");
+  Serial.print(100.0 * stats.busy / stats.ticks, 1);
+  Serial.println(" %");
+  Serial.print("Missed deadlines: ");
+  Serial.println(stats.missed);
+
+  if (0 == stats.frames) {
+    return;
+  }
+
+  /* Interrupt time per frame, in CPU cycles */
+  Serial.println("Cycles per frame loading each plane:");
+  for (uint8_t p = 0; p < RGBMATRIX_PLANES; p++) {
+    Serial.print("  plane ");
+    Serial.print(p);
+    Serial.print(": ");
+    Serial.println(stats.planebusy[p] / stats.frames);
+  }
+  Serial.println("Cycles per frame loading each row:");
+  for (uint8_t r = 0; r < matrix.height() / 2; r++) {
+    Serial.print("  row ");
+    Serial.print(r);
+    Serial.print(": ");
+    Serial.println(stats.rowbusy[r] / stats.frames);
+  }
+#else
+  LOG_ERROR("Statistics need a build with -D RGBMATRIX_STATS.");
+#endif
+}
+
+/**
+ * @brief Show or set the time the display refresh waits for the row address lines to settle
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_addr_delay(Cmd *thisCmd, char *command, bool printHelp) {
+  char *parsed = NULL;
+  int32_t delay_us = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for addr_delay command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the current setting */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    delay_us = atoi(parsed);
+    if (delay_us < 0 || delay_us > 100) {
+      LOG_ERROR("Delay must be between 0 and 100 us.");
+
+      return;
+    }
+    matrix.setAddressDelay(delay_us);
+  }
+
+  Serial.print("Address settle time: ");
+  Serial.print(matrix.addressDelay());
+  Serial.println(" us");
+}
+
+/**
+ * @brief Measure refresh rate and CPU load for several address settle times (needs RGBMATRIX_STATS)
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void run_addr_delay_benchmark(Cmd *thisCmd, char *command, bool printHelp) {
+#ifdef RGBMATRIX_STATS
+  const uint8_t delays_us[] = {10, 5, 2, 1, 0};
+  uint8_t saved_us = matrix.addressDelay();
+  RGBmatrixStats stats;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for run_addr_delay_benchmark command.");
+
+    return;
+  }
+
+  LOG_DEBUG("Running address delay benchmark...");
+
+  for (size_t i = 0; i < sizeof(delays_us) / sizeof(delays_us[0]); i++) {
+    matrix.setAddressDelay(delays_us[i]);
+
+    /* Measure one second of refresh at this setting */
+    matrix.getStats(&stats, true);
+    delay(1000);
+    matrix.getStats(&stats, true);
+
+    Serial.print(delays_us[i]);
+    Serial.print(" us: ");
+    Serial.print(stats.ticks ? (double)stats.frames * F_CPU / stats.ticks : 0.0, 1);
+    Serial.print(" Hz, CPU load ");
+    Serial.print(stats.ticks ? 100.0 * stats.busy / stats.ticks : 0.0, 1);
+    Serial.print(" %, missed deadlines ");
+    Serial.println(stats.missed);
+  }
+
+  matrix.setAddressDelay(saved_us);
+
+  LOG_DEBUG("Address delay benchmark complete.");
+#else
+  LOG_ERROR("The benchmark needs a build with -D RGBMATRIX_STATS.");
+#endif
+}
+
+/**
+ * @brief Show or set the display brightness
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_brightness(Cmd *thisCmd, char *command, bool printHelp) {
+  char *parsed = NULL;
+  int32_t level = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for brightness command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the current setting */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    level = atoi(parsed);
+    if (level < 0 || level > 255) {
+      LOG_ERROR("Brightness must be between 0 and 255.");
+
+      return;
+    }
+    matrix.setBrightness(level);
+  }
+
+  Serial.print("Brightness: ");
+  Serial.println(matrix.getBrightness());
+}
+
+/**
+ * @brief Show the refresh rate, or lock it to a whole multiple of a camera frame rate
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_refresh_lock(Cmd *thisCmd, char *command, bool printHelp) {
+  char *parsed = NULL;
+  double fps = 0.0;
+  double locked = 0.0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for refresh_lock command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the current rate */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    fps = atof(parsed);
+    if (fps < 0.0 || fps > 1000.0) {
+      LOG_ERROR("Frame rate must be between 0 and 1000 fps.");
+
+      return;
+    }
+    locked = matrix.lockRefreshRate(fps);
+    if (fps > 0.0 && locked == 0.0) {
+      LOG_ERROR("Frame rate is above the fastest refresh rate, refresh is free-running.");
+    }
+  }
+
+  Serial.print("Refresh rate: ");
+  Serial.print(matrix.refreshRate(), 3);
+  if (locked > 0.0) {
+    Serial.print(" Hz, ");
+    Serial.print(locked / fps, 0);
+    Serial.println(" refreshes per camera frame");
+  } else {
+    Serial.println(" Hz");
+  }
+}
+
+/**
+ * @brief Show the refresh phase against a camera VSYNC input, or start or stop syncing to one
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_vsync(Cmd *thisCmd, char *command, bool printHelp) {
+  static int8_t sync_pin = -1;
+  char *parsed = NULL;
+  int32_t window_us = 100;
+  RGBmatrixSync sync;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for vsync command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the status */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    if (0 == strcmp(parsed, "off")) {
+      matrix.syncTo(-1);
+      sync_pin = -1;
+      Serial.println("Sync off");
+
+      return;
+    }
+
+    sync_pin = atoi(parsed);
+    parsed = cmd->Parse();
+    if (parsed != NULL) {
+      window_us = atoi(parsed);
+      if (window_us < 1 || window_us > 10000) {
+        LOG_ERROR("Window must be between 1 and 10000 us.");
+
+        return;
+      }
+    }
+    if (!matrix.syncTo(sync_pin, window_us)) {
+      LOG_ERROR("Pin has no external interrupt.");
+      sync_pin = -1;
+
+      return;
+    }
+  }
+
+  if (sync_pin < 0) {
+    Serial.println("Sync off");
+
+    return;
+  }
+
+  matrix.getSync(&sync, true);
+  Serial.print("Sync on pin ");
+  Serial.print(sync_pin);
+  Serial.print(sync.locked ? ": locked" : ": not locked");
+  Serial.print(", edges ");
+  Serial.print(sync.edges);
+  Serial.print(", restarts ");
+  Serial.print(sync.restarts);
+  Serial.print(", phase error ");
+  Serial.print(sync.error);
+  Serial.println(" us");
+}
+
+/**
+ * @brief Set the output pin toggled as each swapped frame goes on display
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_present_pin(Cmd *thisCmd, char *command, bool printHelp) {
+  char *parsed = NULL;
+  int32_t pin = -1;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for present_pin command.");
+
+    return;
+  }
+
+  parsed = cmd->Parse();
+  if (parsed == NULL) {
+    LOG_ERROR("Usage: present_pin <pin> | off");
+
+    return;
+  }
+  if (0 != strcmp(parsed, "off")) {
+    pin = atoi(parsed);
+    if (pin < 0 || pin >= NUM_DIGITAL_PINS) {
+      LOG_ERROR("Invalid pin.");
+
+      return;
+    }
+  }
+
+  matrix.setSwapPin(pin);
+  if (pin < 0) {
+    Serial.println("Present pin off");
+  } else {
+    Serial.print("Present pin ");
+    Serial.println(pin);
+  }
+}
+
+/**
+ * @brief Print the frame number and time of each swapped frame put on display since the last
+ *        call, one per line with the time since the frame before (needs RGBMATRIX_PRESENT_LOG)
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void print_present_log(Cmd *thisCmd, char *command, bool printHelp) {
+#ifdef RGBMATRIX_PRESENT_LOG
+  static uint32_t last_us = 0;
+  RGBmatrixPresent entries[8];
+  uint32_t lost = 0;
+  uint32_t overwritten = 0;
+  uint32_t total = 0;
+  uint8_t n = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for present_log command.");
+
+    return;
+  }
+
+  Serial.println("frame us +us");
+  while ((n = matrix.readPresentLog(entries, 8, &overwritten)) > 0) {
+    lost += overwritten;
+    for (uint8_t i = 0; i < n; i++) {
+      Serial.print(entries[i].frame);
+      Serial.print(' ');
+      Serial.print(entries[i].us);
+      Serial.print(' ');
+      Serial.println(last_us ? entries[i].us - last_us : 0);
+      last_us = entries[i].us;
+    }
+    total += n;
+  }
+  lost += overwritten;
+
+  Serial.print(total);
+  Serial.print(" frames, ");
+  Serial.print(lost);
+  Serial.println(" lost");
+#else
+  LOG_ERROR("The log needs a build with -D RGBMATRIX_PRESENT_LOG=n.");
+#endif
+}
+
+/**
+ * @brief Show or set temporal dithering, which alternates frames between the two nearest panel
+ *        levels to show one more bit of each 5/6/5 color component
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_dither(Cmd *thisCmd, char *command, bool printHelp) {
+  char *parsed = NULL;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for dither command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the current setting */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    if (0 == strcmp(parsed, "on")) {
+      if (!matrix.setDither(true)) {
+        LOG_ERROR("Dithering needs RAM for a second image of each buffer, and 5 planes or less.");
+
+        return;
+      }
+    } else if (0 == strcmp(parsed, "off")) {
+      matrix.setDither(false);
+    } else {
+      LOG_ERROR("Usage: dither [on | off]");
+
+      return;
+    }
+  }
+
+  Serial.print("Dither: ");
+  Serial.println(matrix.getDither() ? "on" : "off");
+}
+
+/**
+ * @brief Show or set how the refresh treats all-black rows: scanned as usual, skipped to save CPU
+ *        time (idle) or skipped and passed by quickly for a higher refresh rate (fast)
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_blank_rows(Cmd *thisCmd, char *command, bool printHelp) {
+  static const char *const names[] = {"scan", "idle", "fast"};
+  char *parsed = NULL;
+  uint8_t mode = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for blank_rows command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the current setting */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    while (mode < 3 && 0 != strcmp(parsed, names[mode])) {
+      mode++;
+    }
+    if (mode >= 3) {
+      LOG_ERROR("Usage: blank_rows [scan | idle | fast]");
+
+      return;
+    }
+    matrix.setBlankRows((RGBmatrixBlankRows)mode);
+  }
+
+  Serial.print("Blank rows: ");
+  Serial.println(names[matrix.blankRows()]);
+}
+
+/*
+ * Pattern generators for the pattern command. They run in the refresh interrupt, once per
+ * matrix row and frame, so they only compute each pixel's color from its position.
+ */
+
+/**
+ * @brief White lines every 8 pixels on black
+ * @param y Matrix row
+ * @param frame Refresh frame number
+ * @param colors Row of colors to fill
+ */
+static
+void pattern_grid(int16_t y, uint16_t frame, uint16_t *colors) {
+  for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+    colors[x] = ((0 == (x & 7)) || (0 == (y & 7))) ? COLOR_WHITE : COLOR_BLACK;
+  }
+}
+
+/**
+ * @brief White, yellow, cyan, green, magenta, red, blue and black vertical stripes, 8 pixels wide,
+ *        as in the grid generator test
+ * @param y Matrix row
+ * @param frame Refresh frame number
+ * @param colors Row of colors to fill
+ */
+static
+void pattern_stripes(int16_t y, uint16_t frame, uint16_t *colors) {
+  static const uint16_t stripes[] = {COLOR_WHITE, COLOR_YELLOW, COLOR_CYAN, COLOR_GREEN,
+                                     COLOR_MAGENTA, COLOR_RED, COLOR_BLUE, COLOR_BLACK};
+
+  for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+    colors[x] = stripes[(x >> 3) & 7];
+  }
+}
+
+/**
+ * @brief White and black checkerboard of 8x8 pixel squares
+ * @param y Matrix row
+ * @param frame Refresh frame number
+ * @param colors Row of colors to fill
+ */
+static
+void pattern_checker(int16_t y, uint16_t frame, uint16_t *colors) {
+  for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+    colors[x] = ((x ^ y) & 8) ? COLOR_WHITE : COLOR_BLACK;
+  }
+}
+
+/**
+ * @brief Gray, red, green and blue ramps, as in the gradient test
+ * @param y Matrix row
+ * @param frame Refresh frame number
+ * @param colors Row of colors to fill
+ */
+static
+void pattern_gradient(int16_t y, uint16_t frame, uint16_t *colors) {
+  uint8_t band = y / (matrix.height() / 4);
+  uint16_t r5 = 0;
+  uint16_t g6 = 0;
+
+  for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+    r5 = (x * 32) / MATRIX_WIDTH;
+    g6 = (x * 64) / MATRIX_WIDTH;
+    switch (band) {
+    case 0:
+      colors[x] = (r5 << 11) | (g6 << 5) | r5;
+      break;
+    case 1:
+      colors[x] = r5 << 11;
+      break;
+    case 2:
+      colors[x] = g6 << 5;
+      break;
+    default:
+      colors[x] = r5;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief White vertical line moving one column to the right every refresh frame, on black
+ * @param y Matrix row
+ * @param frame Refresh frame number
+ * @param colors Row of colors to fill
+ */
+static
+void pattern_sweep(int16_t y, uint16_t frame, uint16_t *colors) {
+  for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+    colors[x] = (x == (frame % MATRIX_WIDTH)) ? COLOR_WHITE : COLOR_BLACK;
+  }
+}
+
+/**
+ * @brief Show or set a pattern generated by the refresh interrupt in place of the display buffer
+ *        (off shows the buffer again). Patterns switch instantly and animate at the refresh rate.
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_pattern(Cmd *thisCmd, char *command, bool printHelp) {
+  static const char *const names[] = {"grid", "stripes", "checker", "gradient", "sweep", "off"};
+  static const RGBmatrixPattern generators[] = {pattern_grid, pattern_stripes, pattern_checker,
+                                                pattern_gradient, pattern_sweep, NULL};
+  char *parsed = NULL;
+  uint8_t i = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for pattern command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the current setting */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    while (i < 6 && 0 != strcmp(parsed, names[i])) {
+      i++;
+    }
+    if (i >= 6) {
+      LOG_ERROR("Usage: pattern [grid | stripes | checker | gradient | sweep | off]");
+
+      return;
+    }
+    if (!matrix.setPattern(generators[i])) {
+      LOG_ERROR("Not enough RAM for the pattern row.");
+
+      return;
+    }
+  }
+
+  i = 0;
+  while (i < 5 && generators[i] != matrix.getPattern()) {
+    i++;
+  }
+  Serial.print("Pattern: ");
+  Serial.println(names[i]);
+}
+
+/**
+ * @brief Show or set the rectangle that drawing is confined to, e.g. to run a test in one pane of
+ *        a split screen (off draws on the whole display again)
+ * @param Cmd pointer to command object
+ * @param command Command string
+ * @param printHelp Flag indicating whether to print help
+ */
+static
+void set_clip(Cmd *thisCmd, char *command, bool printHelp) {
+  char *parsed = NULL;
+  int16_t rect[4] = {0};
+  uint8_t i = 0;
+
+  if (NULL == thisCmd || NULL == command) {
+    LOG_ERROR("Invalid arguments for clip command.");
+
+    return;
+  }
+
+  /* Without an argument, just show the current setting */
+  parsed = cmd->Parse();
+  if (parsed != NULL) {
+    if (0 == strcmp(parsed, "off")) {
+      matrix.resetClip();
+    } else {
+      for (i = 0; i < 4 && parsed != NULL; i++) {
+        rect[i] = atoi(parsed);
+        parsed = (i < 3) ? cmd->Parse() : NULL;
+      }
+      if (i < 4) {
+        LOG_ERROR("Usage: clip [x y w h | off]");
+
+        return;
+      }
+      matrix.setClipRect(rect[0], rect[1], rect[2], rect[3]);
+    }
+  }
+
+  matrix.getClipRect(&rect[0], &rect[1], &rect[2], &rect[3]);
+  Serial.print("Clip: ");
+  Serial.print(rect[0]);
+  Serial.print(" ");
+  Serial.print(rect[1]);
+  Serial.print(" ");
+  Serial.print(rect[2]);
+  Serial.print(" ");
+  Serial.println(rect[3]);
+}
+
 /**
  * @brief Arduino setup function
  */
@@ -622,10 +1655,26 @@ void setup() {
   cmd->AddCmd(PSTR("help"), print_help);
 	cmd->AddCmd(PSTR("run_scrolling_text_test"), run_scrolling_text_test);
 	cmd->AddCmd(PSTR("run_countdown_test"), run_countdown_tests);
+  cmd->AddCmd(PSTR("run_ticker_test"), run_ticker_test);
   cmd->AddCmd(PSTR("run_fill_screen_test"), run_fill_screen_test);
   cmd->AddCmd(PSTR("run_vertical_line_test"), run_vertical_line_test);
   cmd->AddCmd(PSTR("run_horizontal_line_test"), run_horizontal_line_test);
   cmd->AddCmd(PSTR("run_grid_generator_test"), run_grid_generatior_test);
+  cmd->AddCmd(PSTR("run_gradient_test"), run_gradient_test);
+  cmd->AddCmd(PSTR("run_draw_benchmark"), run_draw_benchmark);
+  cmd->AddCmd(PSTR("frame_crc"), print_frame_crc);
+  cmd->AddCmd(PSTR("stats"), print_stats);
+  cmd->AddCmd(PSTR("addr_delay"), set_addr_delay);
+  cmd->AddCmd(PSTR("run_addr_delay_benchmark"), run_addr_delay_benchmark);
+  cmd->AddCmd(PSTR("brightness"), set_brightness);
+  cmd->AddCmd(PSTR("refresh_lock"), set_refresh_lock);
+  cmd->AddCmd(PSTR("vsync"), set_vsync);
+  cmd->AddCmd(PSTR("present_pin"), set_present_pin);
+  cmd->AddCmd(PSTR("present_log"), print_present_log);
+  cmd->AddCmd(PSTR("dither"), set_dither);
+  cmd->AddCmd(PSTR("blank_rows"), set_blank_rows);
+  cmd->AddCmd(PSTR("pattern"), set_pattern);
+  cmd->AddCmd(PSTR("clip"), set_clip);
 
 	/* Print a line indicator to inform the user the cli is ready. */
   cmd->SetLineIndicator("> ");
@@ -0,0 +1,403 @@
+/**
+****************************************************************************************************
+*    @file           : test_main.cpp
+*    @brief          : Adafruit_GFX clip rectangle tests for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    Random primitives are drawn twice, once with a random clip rectangle set and once
+*    without: inside the rectangle both must match, outside it the clipped drawing must
+*    have left every pixel as it was. This is checked on a subclass that only overrides
+*    drawPixel(), on the three canvases and on the matrix (read back from its buffer).
+*    Unclipped, the drawPixel()-only subclass must draw exactly what the library drew
+*    before the clip rectangle was added.
+*
+*    Run with: pio test -e native -f test_gfx_clip
+*
+****************************************************************************************************
+*/
+
+#include <unistd.h>
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "RGBmatrixPanel.h"
+
+#define PLAIN_WIDTH  48
+#define PLAIN_HEIGHT 40
+
+/* FNV-1a hash of 20000 unclipped primitives on Plain, as drawn by the library before the clip
+   rectangle (same seed and operations) */
+#define PLAIN_HASH 0x7A5BCF30u
+
+RGBmatrixPanel matrix(A0, A1, A2, A3, 11, 10, 9, false, 64);
+
+/* A display that only overrides drawPixel(), as the simplest subclasses do */
+class Plain : public Adafruit_GFX {
+public:
+  Plain() : Adafruit_GFX(PLAIN_WIDTH, PLAIN_HEIGHT) {
+    memset(buffer, 0, sizeof(buffer));
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) {
+      return;
+    }
+    buffer[offset(x, y)] = color;
+  }
+
+  uint16_t getPixel(int16_t x, int16_t y) {
+    return buffer[offset(x, y)];
+  }
+
+  uint16_t buffer[PLAIN_WIDTH * PLAIN_HEIGHT];
+
+private:
+  int offset(int16_t x, int16_t y) {
+    int16_t t;
+
+    switch (rotation) {
+    case 1:
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+    }
+
+    return y * WIDTH + x;
+  }
+};
+
+/* Test images and font */
+static uint8_t fontBits[64];
+static GFXglyph fontGlyphs[3] = {{0, 7, 9, 8, 0, -9}, {10, 5, 12, 6, -1, -10},
+                                 {20, 9, 6, 10, 1, -4}};
+static GFXfont font = {fontBits, fontGlyphs, 'A', 'C', 14};
+static uint8_t bits[8 * 20];
+static uint8_t mask[4 * 20];
+static uint16_t rgb[30 * 20];
+static uint8_t gray[30 * 20];
+
+/* The primitive to draw: operation, coordinates and colors */
+static int op;
+static int arg[8];
+static uint16_t color;
+static uint16_t color2;
+
+static uint16_t before[64 * 32];
+static uint16_t unclipped[64 * 32];
+
+static uint32_t seed;
+
+/* xorshift32, so that the sequence (and PLAIN_HASH) does not depend on the C library */
+static uint32_t nextRandom(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return seed;
+}
+
+static int nextRandom(int n) {
+  return nextRandom() % n;
+}
+
+static void randomData(void) {
+  for (unsigned int i = 0; i < sizeof(fontBits); i++) {
+    fontBits[i] = nextRandom();
+  }
+  for (unsigned int i = 0; i < sizeof(bits); i++) {
+    bits[i] = nextRandom();
+  }
+  for (unsigned int i = 0; i < sizeof(mask); i++) {
+    mask[i] = nextRandom();
+  }
+  for (unsigned int i = 0; i < 30 * 20; i++) {
+    rgb[i] = nextRandom();
+    gray[i] = nextRandom();
+  }
+}
+
+static void randomOperation(Adafruit_GFX *gfx) {
+  op = nextRandom(16);
+  for (int i = 0; i < 8; i++) {
+    arg[i] = nextRandom(gfx->width() + 40) - 20;
+  }
+  color = nextRandom();
+  color2 = nextRandom();
+  arg[6] = nextRandom(3) + 1;
+}
+
+/* Negative and zero lengths and sizes included */
+static void draw(Adafruit_GFX *gfx) {
+  int16_t x = arg[0], y = arg[1];
+
+  switch (op) {
+  case 0:
+    gfx->drawLine(arg[0], arg[1], arg[2], arg[3], color);
+    break;
+  case 1:
+    gfx->drawFastHLine(x, y, arg[2] - 30, color);
+    break;
+  case 2:
+    gfx->drawFastVLine(x, y, arg[2] - 30, color);
+    break;
+  case 3:
+    gfx->fillRect(x, y, arg[2] - 10, arg[3] - 10, color);
+    break;
+  case 4:
+    gfx->drawCircle(x, y, arg[2] % 20, color);
+    break;
+  case 5:
+    gfx->fillCircle(x, y, arg[2] % 20, color);
+    break;
+  case 6:
+    gfx->drawRect(x, y, arg[2] - 30, arg[3] - 30, color);
+    break;
+  case 7:
+    gfx->fillTriangle(arg[0], arg[1], arg[2], arg[3], arg[4], arg[5], color);
+    break;
+  case 8:
+    gfx->drawRoundRect(x, y, arg[2] % 30 + 1, arg[3] % 30 + 1, 4, color);
+    break;
+  case 9:
+    gfx->setFont(NULL);
+    gfx->setTextSize(arg[6]);
+    gfx->setTextWrap(false);
+    gfx->setCursor(x, y);
+    gfx->setTextColor(color, (arg[4] & 1) ? color : color2);
+    gfx->print("Hi!x");
+    break;
+  case 10:
+    gfx->setFont(&font);
+    gfx->setTextSize(arg[6]);
+    gfx->setTextWrap(false);
+    gfx->setCursor(x, y);
+    gfx->setTextColor(color);
+    gfx->print("ABCA");
+    gfx->setFont(NULL);
+    break;
+  case 11:
+    gfx->drawBitmap(x, y, bits, arg[2] % 60 + 1, 20, color, color2);
+    break;
+  case 12:
+    gfx->drawXBitmap(x, y, bits, arg[2] % 60 + 1, 20, color);
+    break;
+  case 13:
+    gfx->drawRGBBitmap(x, y, rgb, 30, 20);
+    break;
+  case 14:
+    gfx->drawRGBBitmap(x, y, rgb, mask, 30, 20);
+    break;
+  default:
+    gfx->drawGrayscaleBitmap(x, y, gray, mask, 30, 20);
+    break;
+  }
+}
+
+/* A random clip rectangle, sometimes partly or wholly off screen or empty */
+static void randomClip(Adafruit_GFX *gfx) {
+  gfx->setClipRect(nextRandom(gfx->width() + 20) - 10, nextRandom(gfx->height() + 20) - 10,
+                   nextRandom(gfx->width()), nextRandom(gfx->height()));
+}
+
+static bool inClip(Adafruit_GFX *gfx, int16_t x, int16_t y) {
+  int16_t cx, cy, cw, ch;
+
+  gfx->getClipRect(&cx, &cy, &cw, &ch);
+
+  return (x >= cx) && (y >= cy) && (x < cx + cw) && (y < cy + ch);
+}
+
+/* Unclipped output is unchanged from before the clip rectangle */
+static void test_plain_unclipped(void) {
+  uint32_t hash = 2166136261u;
+
+  seed = 7;
+  randomData();
+  for (int i = 0; i < 20000; i++) {
+    Plain plain;
+
+    plain.setRotation(nextRandom(4));
+    randomOperation(&plain);
+    draw(&plain);
+    for (int p = 0; p < PLAIN_WIDTH * PLAIN_HEIGHT; p++) {
+      hash = (hash ^ plain.buffer[p]) * 16777619u;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_HEX32(PLAIN_HASH, hash);
+}
+
+/* A subclass overriding drawPixel() alone is clipped too */
+static void test_plain_clipped(void) {
+  seed = 11;
+  randomData();
+  for (int i = 0; i < 5000; i++) {
+    Plain plain, clipped;
+
+    plain.setRotation(nextRandom(4));
+    clipped.setRotation(plain.getRotation());
+    randomOperation(&plain);
+    randomClip(&clipped);
+    draw(&plain);
+    draw(&clipped);
+    for (int16_t y = 0; y < plain.height(); y++) {
+      for (int16_t x = 0; x < plain.width(); x++) {
+        TEST_ASSERT_EQUAL_HEX16(inClip(&clipped, x, y) ? plain.getPixel(x, y) : 0,
+                                clipped.getPixel(x, y));
+      }
+    }
+  }
+}
+
+template <class Canvas> static void checkCanvas(void) {
+  seed = 5;
+  randomData();
+  for (int i = 0; i < 3000; i++) {
+    Canvas canvas(PLAIN_WIDTH, PLAIN_HEIGHT), clipped(PLAIN_WIDTH, PLAIN_HEIGHT);
+    uint16_t *old = before;
+
+    canvas.setRotation(nextRandom(4));
+    clipped.setRotation(canvas.getRotation());
+    for (int16_t y = 0; y < canvas.height(); y++) {
+      for (int16_t x = 0; x < canvas.width(); x++) {
+        uint16_t c = nextRandom();
+
+        canvas.drawPixel(x, y, c);
+        clipped.drawPixel(x, y, c);
+        *old++ = clipped.getPixel(x, y);
+      }
+    }
+    randomOperation(&canvas);
+    randomClip(&clipped);
+    if (nextRandom(10) == 0) {
+      canvas.fillScreen(color);
+      clipped.fillScreen(color);
+    } else {
+      draw(&canvas);
+      draw(&clipped);
+    }
+    for (int16_t y = 0; y < canvas.height(); y++) {
+      for (int16_t x = 0; x < canvas.width(); x++) {
+        TEST_ASSERT_EQUAL_HEX16(inClip(&clipped, x, y) ? canvas.getPixel(x, y)
+                                                       : before[y * canvas.width() + x],
+                                clipped.getPixel(x, y));
+      }
+    }
+  }
+}
+
+static void test_canvas1_clipped(void) {
+  checkCanvas<GFXcanvas1>();
+}
+
+static void test_canvas8_clipped(void) {
+  checkCanvas<GFXcanvas8>();
+}
+
+static void test_canvas16_clipped(void) {
+  checkCanvas<GFXcanvas16>();
+}
+
+/* The matrix's own primitives, canvas blits and scrolling, in every rotation */
+static void test_matrix_clipped(void) {
+  GFXcanvas16 canvas(20, 12);
+
+  seed = 3;
+  randomData();
+  for (int i = 0; i < 3000; i++) {
+    int16_t w, h, scroll;
+    int kind;
+
+    matrix.setRotation(nextRandom(4));
+    w = matrix.width();
+    h = matrix.height();
+    for (int p = 0; p < 20 * 12; p++) {
+      canvas.getBuffer()[p] = nextRandom();
+    }
+    for (int16_t y = 0; y < h; y++) {
+      for (int16_t x = 0; x < w; x++) {
+        matrix.drawPixel(x, y, nextRandom());
+        before[y * w + x] = matrix.getPixel(x, y);
+      }
+    }
+    randomOperation(&matrix);
+    kind = nextRandom(12);
+    scroll = nextRandom(40) - 20;
+
+    for (int pass = 0; pass < 2; pass++) {
+      if (pass) {
+        for (int16_t y = 0; y < h; y++) {
+          for (int16_t x = 0; x < w; x++) {
+            unclipped[y * w + x] = matrix.getPixel(x, y);
+            matrix.drawPixel(x, y, before[y * w + x]);
+          }
+        }
+        randomClip(&matrix);
+      }
+      if (kind == 0) {
+        matrix.fillScreen(color);
+      } else if (kind == 1) {
+        matrix.drawCanvas(arg[0], arg[1], &canvas);
+      } else if (kind == 2) {
+        matrix.scrollRect(arg[0], arg[1], arg[2], arg[3], scroll, color);
+      } else {
+        draw(&matrix);
+      }
+    }
+
+    /* Scrolled in from outside the clip, the pixels inside differ: only outside is checked */
+    for (int16_t y = 0; y < h; y++) {
+      for (int16_t x = 0; x < w; x++) {
+        if (!inClip(&matrix, x, y)) {
+          TEST_ASSERT_EQUAL_HEX16(before[y * w + x], matrix.getPixel(x, y));
+        } else if (kind != 2) {
+          TEST_ASSERT_EQUAL_HEX16(unclipped[y * w + x], matrix.getPixel(x, y));
+        }
+      }
+    }
+    matrix.resetClip();
+  }
+}
+
+void setUp(void) {
+  matrix.resetClip();
+  matrix.setRotation(0);
+}
+
+void tearDown(void) {
+}
+
+void setup() {
+  int failures;
+
+  matrix.begin();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_plain_unclipped);
+  RUN_TEST(test_plain_clipped);
+  RUN_TEST(test_canvas1_clipped);
+  RUN_TEST(test_canvas8_clipped);
+  RUN_TEST(test_canvas16_clipped);
+  RUN_TEST(test_matrix_clipped);
+  failures = UNITY_END();
+
+  /* Stop the refresh interrupt, as main() does at the end of input */
+  cli();
+  fflush(stdout);
+  _exit(failures);
+}
+
+void loop() {
+}
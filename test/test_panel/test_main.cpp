@@ -0,0 +1,164 @@
+/**
+****************************************************************************************************
+*    @file           : test_main.cpp
+*    @brief          : RGBmatrixPanel tests for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    Canvas blits must match the generic bitmap functions pixel for pixel (in every rotation,
+*    clipped at the screen edges, dithered or not), and buffer swaps must hold up however the
+*    caller polls for them. The matrix is double buffered, read back from its back buffer
+*    with readRow(), and refreshed by the emulated Timer1 interrupt throughout.
+*
+*    Bitplane conversion depends on the plane count, which is a build flag; to cover another:
+*    PLATFORMIO_BUILD_FLAGS="-D RGBMATRIX_PLANES=6" pio test -e native -f test_panel
+*
+****************************************************************************************************
+*/
+
+#include <unistd.h>
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "RGBmatrixPanel.h"
+
+#define MATRIX_WIDTH  64
+#define MATRIX_HEIGHT 32
+
+RGBmatrixPanel matrix(A0, A1, A2, A3, 11, 10, 9, true, MATRIX_WIDTH);
+
+static uint16_t blitted[MATRIX_HEIGHT][MATRIX_WIDTH];
+static uint16_t expected[MATRIX_HEIGHT][MATRIX_WIDTH];
+
+static uint32_t seed;
+
+/* xorshift32, so that the sequence does not depend on the C library */
+static uint32_t nextRandom(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return seed;
+}
+
+static int nextRandom(int n) {
+  return nextRandom() % n;
+}
+
+static void readMatrix(uint16_t (*image)[MATRIX_WIDTH]) {
+  for (int16_t y = 0; y < MATRIX_HEIGHT; y++) {
+    matrix.readRow(y, image[y]);
+  }
+}
+
+static void clearMatrix(uint8_t rotation) {
+  matrix.setRotation(0);
+  matrix.fillScreen(0x1234);
+  matrix.setRotation(rotation);
+}
+
+/* Random canvases, partly off screen, blitted against drawRGBBitmap() and drawBitmap() */
+static void checkBlits(void) {
+  for (int i = 0; i < 400; i++) {
+    int16_t w = 1 + nextRandom(70), h = 1 + nextRandom(40);
+    int16_t x = nextRandom(90) - 20, y = nextRandom(60) - 20;
+    uint8_t rotation = nextRandom(4);
+    GFXcanvas16 canvas(w, h);
+    GFXcanvas1 mono(w, h);
+    uint16_t color, background;
+
+    for (int16_t j = 0; j < h; j++) {
+      for (int16_t k = 0; k < w; k++) {
+        canvas.drawPixel(k, j, nextRandom());
+        mono.drawPixel(k, j, nextRandom(2));
+      }
+    }
+
+    clearMatrix(rotation);
+    matrix.drawCanvas(x, y, &canvas);
+    readMatrix(blitted);
+    clearMatrix(rotation);
+    matrix.drawRGBBitmap(x, y, canvas.getBuffer(), w, h);
+    readMatrix(expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, blitted, sizeof(blitted));
+
+    color = nextRandom();
+    background = nextRandom();
+    matrix.drawCanvas(x, y, &mono, color, background);
+    readMatrix(blitted);
+    matrix.drawBitmap(x, y, mono.getBuffer(), w, h, color, background);
+    readMatrix(expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, blitted, sizeof(blitted));
+  }
+}
+
+static void test_blit_matches_bitmap(void) {
+  seed = 11;
+  checkBlits();
+}
+
+static void test_blit_matches_bitmap_dithered(void) {
+  /* Dithering needs 5 planes or fewer */
+  if (!matrix.setDither(true)) {
+    TEST_MESSAGE("Dithering not available with this plane count");
+    return;
+  }
+  seed = 13;
+  checkBlits();
+  matrix.setDither(false);
+}
+
+/* Two swaps with no poll in between: the second settles the first, so the buffers alternate */
+static void test_swap_unpolled(void) {
+  uint8_t *back;
+  uint16_t blue;
+
+  matrix.fillScreen(0xF800);
+  matrix.swapBuffers(true);
+  back = matrix.backBuffer();
+
+  matrix.fillScreen(0x001F);
+  blue = matrix.getPixel(0, 0); /* As stored, at this plane count */
+  TEST_ASSERT_TRUE(matrix.swapBuffersAsync(true));
+  delay(50); /* Several refresh cycles: swapped, but never polled for */
+  TEST_ASSERT_TRUE(matrix.swapBuffersAsync(false));
+  while (!matrix.swapComplete()) {
+  }
+
+  TEST_ASSERT_EQUAL_PTR(back, matrix.backBuffer());
+  TEST_ASSERT_EQUAL_HEX16(blue, matrix.getPixel(0, 0)); /* Copied by the first swap */
+}
+
+/* Once the refresh interrupt reads the buffers, they can no longer be reallocated */
+static void test_triple_buffering_after_begin(void) {
+  TEST_ASSERT_FALSE(matrix.enableTripleBuffering());
+}
+
+void setUp(void) {
+  matrix.setRotation(0);
+}
+
+void tearDown(void) {
+}
+
+void setup() {
+  int failures;
+
+  matrix.begin();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_blit_matches_bitmap);
+  RUN_TEST(test_blit_matches_bitmap_dithered);
+  RUN_TEST(test_swap_unpolled);
+  RUN_TEST(test_triple_buffering_after_begin);
+  failures = UNITY_END();
+
+  /* Stop the refresh interrupt, as main() does at the end of input */
+  cli();
+  fflush(stdout);
+  _exit(failures);
+}
+
+void loop() {
+}
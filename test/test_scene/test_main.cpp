@@ -0,0 +1,241 @@
+/**
+****************************************************************************************************
+*    @file           : test_main.cpp
+*    @brief          : RGBmatrixScene display list tests for the host-native build
+****************************************************************************************************
+*
+*    @description:
+*    The display list must always leave the matrix as a full redraw would: after random
+*    edits, update() is compared with invalidate() and update(), and render() (through
+*    its strip canvas, in every rotation and for several band heights) with update().
+*    The matrix is read back from its buffer with readRow().
+*
+*    Run with: pio test -e native -f test_scene
+*
+****************************************************************************************************
+*/
+
+#include <unistd.h>
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "RGBmatrixPanel.h"
+#include "RGBmatrixScene.h"
+
+#define MATRIX_WIDTH  64
+#define MATRIX_HEIGHT 32
+
+RGBmatrixPanel matrix(A0, A1, A2, A3, 11, 10, 9, false, MATRIX_WIDTH);
+
+static const uint16_t PROGMEM bitmap[6 * 5] = {
+  0xF800, 0x07E0, 0x001F, 0xFFFF, 0x1234, 0x4321,
+  0x0001, 0x0002, 0x0003, 0x0004, 0x0005, 0x0006,
+  0xF800, 0x0000, 0xF800, 0x0000, 0xF800, 0x0000,
+  0x0007, 0x0007, 0x0007, 0x0007, 0x0007, 0x0007,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF
+};
+
+static uint16_t shown[MATRIX_HEIGHT][MATRIX_WIDTH];
+static uint16_t expected[MATRIX_HEIGHT][MATRIX_WIDTH];
+
+static uint32_t seed;
+
+/* xorshift32, so that the sequence does not depend on the C library */
+static uint32_t nextRandom(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return seed;
+}
+
+static int nextRandom(int n) {
+  return nextRandom() % n;
+}
+
+static void readMatrix(uint16_t (*image)[MATRIX_WIDTH]) {
+  for (int16_t y = 0; y < MATRIX_HEIGHT; y++) {
+    matrix.readRow(y, image[y]);
+  }
+}
+
+/* Redrawn only where changed, the screen matches a full redraw after every edit */
+static void test_update_matches_redraw(void) {
+  RGBmatrixScene scene(&matrix, 8, 0x0010);
+  int8_t ids[6];
+  char text[8];
+
+  seed = 3;
+  ids[0] = scene.addRect(5, 5, 20, 10, 0xF800);
+  ids[1] = scene.addText(10, 8, "12", 0x07E0);
+  ids[2] = scene.addLine(0, 0, 63, 31, 0xFFFF);
+  ids[3] = scene.addBitmap(30, 20, bitmap, 6, 5);
+  ids[4] = scene.addRect(40, 2, 15, 15, 0x07FF, false);
+  ids[5] = scene.addText(2, 20, "Hi", 0xF81F, 2);
+
+  for (int i = 0; i < 3000; i++) {
+    int k = nextRandom(6);
+
+    switch (nextRandom(6)) {
+    case 0:
+      scene.moveTo(ids[k], nextRandom(70) - 5, nextRandom(40) - 5);
+      break;
+    case 1:
+      scene.setColor(ids[k], nextRandom());
+      break;
+    case 2:
+      snprintf(text, sizeof(text), "%d", nextRandom(1000));
+      scene.setText(ids[k], text);
+      break;
+    case 3:
+      scene.setVisible(ids[k], nextRandom(2));
+      break;
+    case 4:
+      if (i % 50 == 0) {
+        scene.remove(ids[k]);
+        scene.update();
+        ids[k] = (k % 2) ? scene.addText(nextRandom(60), nextRandom(30), "x", 0xFFE0)
+                         : scene.addRect(nextRandom(60), nextRandom(30), 5, 5, 0x001F);
+      }
+      break;
+    }
+    scene.update();
+    readMatrix(shown);
+    scene.invalidate();
+    scene.update();
+    readMatrix(expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, shown, sizeof(shown));
+  }
+}
+
+/* Rectangles of negative size are kept as fillRect() draws them, empty ones refused */
+static void test_rect_sizes(void) {
+  for (uint8_t rotation = 0; rotation < 4; rotation++) {
+    RGBmatrixScene scene(&matrix, 8);
+    int8_t ids[3];
+
+    matrix.setRotation(rotation);
+    TEST_ASSERT_EQUAL_INT(-1, scene.addRect(5, 5, 10, 0, 0xF800, false));
+    TEST_ASSERT_EQUAL_INT(-1, scene.addRect(5, 5, 0, 3, 0xF800, true));
+    ids[0] = scene.addRect(20, 10, -7, -4, 0xFFFF, false);
+    ids[1] = scene.addRect(30, 20, -1, 5, 0x07E0, true);
+    ids[2] = scene.addRect(40, 8, 9, -1, 0x001F, false);
+
+    seed = 7 + rotation;
+    scene.update();
+    for (int i = 0; i < 200; i++) {
+      scene.moveTo(ids[i % 3], nextRandom(70) - 3, nextRandom(40) - 3);
+      scene.update();
+      readMatrix(shown);
+      TEST_ASSERT_TRUE(scene.render());
+      readMatrix(expected);
+      TEST_ASSERT_EQUAL_MEMORY(expected, shown, sizeof(shown));
+    }
+  }
+}
+
+/* A row written whole reads back as drawn pixel by pixel, dithered or not */
+static void test_write_row(void) {
+  uint16_t row[MATRIX_WIDTH] = {0};
+
+  seed = 5;
+  for (int dither = 0; dither < 2; dither++) {
+    TEST_ASSERT_TRUE(matrix.setDither(dither));
+    for (int i = 0; i < 500; i++) {
+      int16_t y = nextRandom(MATRIX_HEIGHT);
+
+      /* Runs of one color, as writeRow() converts together */
+      for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+        row[x] = nextRandom(4) ? row[(x > 0) ? (x - 1) : 0] : nextRandom();
+      }
+      matrix.writeRow(y, row);
+      matrix.readRow(y, shown[y]);
+      for (int16_t x = 0; x < MATRIX_WIDTH; x++) {
+        matrix.drawPixel(x, y, row[x]);
+      }
+      matrix.readRow(y, expected[y]);
+      TEST_ASSERT_EQUAL_MEMORY(expected[y], shown[y], sizeof(shown[y]));
+    }
+  }
+  matrix.setDither(false);
+}
+
+/* Composited band by band, the list looks as drawn item by item, in every rotation */
+static void test_render_matches_update(void) {
+  static const uint8_t bands[] = {1, 4, 5, 32};
+
+  seed = 9;
+  for (uint8_t rotation = 0; rotation < 4; rotation++) {
+    for (uint8_t b = 0; b < sizeof(bands); b++) {
+      RGBmatrixScene scene(&matrix, 8, 0x0010);
+      int8_t text;
+
+      matrix.setRotation(rotation);
+      scene.addRect(5, 5, 20, 10, 0xF800);
+      scene.addText(10, 8, "12", 0x07E0);
+      scene.addLine(0, 0, 63, 31, 0xFFFF);
+      scene.addBitmap(20, 20, bitmap, 6, 5);
+      scene.addRect(10, 2, 15, 15, 0x07FF, false);
+      text = scene.addText(2, 20, "Hi", 0xF81F, 2);
+
+      for (int i = 0; i < 20; i++) {
+        scene.moveTo(text, nextRandom(40), nextRandom(30));
+        matrix.fillScreen(0x1234);
+        TEST_ASSERT_TRUE(scene.render(bands[b]));
+        readMatrix(shown);
+        scene.invalidate();
+        scene.update();
+        readMatrix(expected);
+        TEST_ASSERT_EQUAL_MEMORY(expected, shown, sizeof(shown));
+
+        /* update() carries on from the rendered screen */
+        scene.moveTo(0, nextRandom(40), nextRandom(30));
+        scene.update();
+        readMatrix(shown);
+        scene.invalidate();
+        scene.update();
+        readMatrix(expected);
+        TEST_ASSERT_EQUAL_MEMORY(expected, shown, sizeof(shown));
+      }
+    }
+  }
+}
+
+/* A band of no rows is refused rather than looped over */
+static void test_render_empty_band(void) {
+  RGBmatrixScene scene(&matrix, 2);
+
+  scene.addRect(0, 0, 4, 4, 0xFFFF);
+  TEST_ASSERT_FALSE(scene.render(0));
+}
+
+void setUp(void) {
+  matrix.setRotation(0);
+  matrix.fillScreen(0);
+}
+
+void tearDown(void) {
+}
+
+void setup() {
+  int failures;
+
+  matrix.begin();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_update_matches_redraw);
+  RUN_TEST(test_rect_sizes);
+  RUN_TEST(test_write_row);
+  RUN_TEST(test_render_matches_update);
+  RUN_TEST(test_render_empty_band);
+  failures = UNITY_END();
+
+  /* Stop the refresh interrupt, as main() does at the end of input */
+  cli();
+  fflush(stdout);
+  _exit(failures);
+}
+
+void loop() {
+}